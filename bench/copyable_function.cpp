@@ -0,0 +1,395 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <catch.hpp>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <utility>
+#include <functional>
+#include <copyable_function.hpp>
+
+namespace {
+	struct small_functor {
+		int val;
+
+		auto operator()(int x) const noexcept -> int { return val + x; }
+	};
+
+	struct big_functor {
+		int val;
+		int buffer[15]{};
+
+		auto operator()(int x) const noexcept -> int { return val + x + buffer[0]; }
+	};
+
+	int free_function(int x) noexcept { return x + 1; }
+
+	template<int I>
+	int throwing_handler(int x) { return x + I; }
+
+	template<int I>
+	int noexcept_handler(int x) noexcept { return x - I; }
+
+	struct message {
+		int id;
+		char payload[124];
+	};
+
+	//! @brief plugin table of free functions with distinct function pointer types converting to the same signature
+	template<typename Function, int... I>
+	auto make_plugin_table(std::integer_sequence<int, I...>) -> std::vector<Function> {
+		std::vector<Function> table;
+		(table.emplace_back(&throwing_handler<I>), ...);
+		(table.emplace_back(&noexcept_handler<I>), ...);
+		return table;
+	}
+
+	static_assert(sizeof(small_functor) <= 3 * sizeof(void *));
+	static_assert(sizeof(big_functor) > 3 * sizeof(void *));
+
+
+	template<typename F>
+	auto invoke(F & func, int arg) -> int {
+		if constexpr(std::is_invocable_v<F &, int>) return func(arg);
+		else if constexpr(std::is_invocable_v<const F &, int>) return std::as_const(func)(arg);
+		else return std::move(func)(arg);
+	}
+
+
+	template<typename Function>
+	void bench_invocation(std::string name) {
+		Function func{small_functor{1}};
+		int arg{0};
+		BENCHMARK(std::move(name)) { return invoke(func, ++arg); };
+	}
+
+	template<template<typename...> typename Function>
+	void bench_qualifiers(const std::string & name) {
+		bench_invocation<Function<int(int)                  >>(name + "<int(int)>");
+		bench_invocation<Function<int(int) const            >>(name + "<int(int) const>");
+		bench_invocation<Function<int(int)       &          >>(name + "<int(int) &>");
+		bench_invocation<Function<int(int) const &          >>(name + "<int(int) const &>");
+		bench_invocation<Function<int(int)       &&         >>(name + "<int(int) &&>");
+		bench_invocation<Function<int(int) const &&         >>(name + "<int(int) const &&>");
+		bench_invocation<Function<int(int)          noexcept>>(name + "<int(int) noexcept>");
+		bench_invocation<Function<int(int) const    noexcept>>(name + "<int(int) const noexcept>");
+		bench_invocation<Function<int(int)       &  noexcept>>(name + "<int(int) & noexcept>");
+		bench_invocation<Function<int(int) const &  noexcept>>(name + "<int(int) const & noexcept>");
+		bench_invocation<Function<int(int)       && noexcept>>(name + "<int(int) && noexcept>");
+		bench_invocation<Function<int(int) const && noexcept>>(name + "<int(int) const && noexcept>");
+	}
+
+
+	template<typename Function, typename Functor>
+	struct construction final {
+		static
+		void run(std::string name) {
+			BENCHMARK_ADVANCED(std::move(name))(Catch::Benchmark::Chronometer meter) {
+				std::vector<Catch::Benchmark::storage_for<Function>> storage(static_cast<std::size_t>(meter.runs()));
+				meter.measure([&](int i) { storage[static_cast<std::size_t>(i)].construct(Functor{i}); });
+			};
+		}
+	};
+
+	template<typename Function, typename Functor>
+	struct move_construction final {
+		static
+		void run(std::string name) {
+			BENCHMARK_ADVANCED(std::move(name))(Catch::Benchmark::Chronometer meter) {
+				std::vector<Function> from(static_cast<std::size_t>(meter.runs()));
+				for(auto & f : from) f = Function{Functor{1}};
+				std::vector<Catch::Benchmark::storage_for<Function>> to(from.size());
+				meter.measure([&](int i) { to[static_cast<std::size_t>(i)].construct(std::move(from[static_cast<std::size_t>(i)])); });
+			};
+		}
+	};
+
+	template<typename Function, typename Functor>
+	struct move_assignment final {
+		static
+		void run(std::string name) {
+			BENCHMARK_ADVANCED(std::move(name))(Catch::Benchmark::Chronometer meter) {
+				std::vector<Function> from(static_cast<std::size_t>(meter.runs())), to(from.size());
+				for(auto & f : from) f = Function{Functor{1}};
+				for(auto & f : to) f = Function{Functor{2}};
+				meter.measure([&](int i) { to[static_cast<std::size_t>(i)] = std::move(from[static_cast<std::size_t>(i)]); });
+			};
+		}
+	};
+
+	template<typename Function, typename Functor>
+	struct swapping final {
+		static
+		void run(std::string name) {
+			Function lhs{Functor{1}}, rhs{Functor{2}};
+			BENCHMARK(std::move(name)) {
+				using std::swap;
+				swap(lhs, rhs);
+				return invoke(lhs, 0);
+			};
+		}
+	};
+
+	template<typename Function, typename Functor>
+	struct copy_construction final {
+		static
+		void run(std::string name) {
+			BENCHMARK_ADVANCED(std::move(name))(Catch::Benchmark::Chronometer meter) {
+				const Function from{Functor{1}};
+				std::vector<Catch::Benchmark::storage_for<Function>> to(static_cast<std::size_t>(meter.runs()));
+				meter.measure([&](int i) { to[static_cast<std::size_t>(i)].construct(from); });
+			};
+		}
+	};
+
+	template<typename Function, typename Functor>
+	struct copy_assignment final {
+		static
+		void run(std::string name) {
+			BENCHMARK_ADVANCED(std::move(name))(Catch::Benchmark::Chronometer meter) {
+				Function from{Functor{1}};
+				std::vector<Function> to(static_cast<std::size_t>(meter.runs()), Function{Functor{2}});
+				meter.measure([&](int i) { to[static_cast<std::size_t>(i)] = from; });
+			};
+		}
+	};
+
+
+	template<std::size_t I>
+	struct tagged_functor {
+		int val;
+
+		auto operator()(int x) const noexcept -> int { return val + x * static_cast<int>(I); }
+	};
+
+	template<typename Function, std::size_t... I>
+	auto make_handlers(std::index_sequence<I...>) -> std::vector<Function> {
+		using factory = Function(*)();
+		const factory factories[]{+[]() -> Function { return Function{tagged_functor<I>{1}}; }...};
+		std::minstd_rand rng{42};
+		std::vector<Function> handlers;
+		for(std::size_t i{0}; i < 4096; ++i) handlers.push_back(factories[rng() % sizeof...(I)]());
+		return handlers;
+	}
+
+	//! @brief invoke many wrappers with different targets, as an event dispatch loop would
+	template<typename Function>
+	void bench_dispatch_loop(std::string name) {
+		auto handlers{make_handlers<Function>(std::make_index_sequence<64>{})};
+		BENCHMARK(std::move(name)) {
+			int sum{0};
+			for(auto & handler : handlers) sum += handler(sum & 7);
+			return sum;
+		};
+	}
+
+
+	//! @brief fill a vector without reserving, measuring relocation of wrappers on growth
+	template<typename Function>
+	void bench_vector_growth(std::string name) {
+		BENCHMARK(std::move(name)) { return make_handlers<Function>(std::make_index_sequence<64>{}); };
+	}
+
+	//! @brief run a benchmark for the owning wrappers and their baselines
+	template<template<typename, typename> typename Bench, typename Functor>
+	void bench_wrappers(const std::string & suffix) {
+		Bench<Functor, Functor>::run("raw template" + suffix);
+		Bench<std::function<int(int)>, Functor>::run("std::function" + suffix);
+#ifdef __cpp_lib_move_only_function
+		Bench<std::move_only_function<int(int) const>, Functor>::run("std::move_only_function" + suffix);
+#endif
+		Bench<p2548::move_only_function<int(int) const>, Functor>::run("p2548::move_only_function" + suffix);
+		Bench<p2548::copyable_function<int(int) const>, Functor>::run("p2548::copyable_function" + suffix);
+	}
+
+	//! @brief run a benchmark for the copyable wrappers and their baselines
+	template<template<typename, typename> typename Bench, typename Functor>
+	void bench_copyable_wrappers(const std::string & suffix) {
+		Bench<Functor, Functor>::run("raw template" + suffix);
+		Bench<std::function<int(int)>, Functor>::run("std::function" + suffix);
+		Bench<p2548::copyable_function<int(int) const>, Functor>::run("p2548::copyable_function" + suffix);
+		Bench<p2548::copyable_function<int(int) const, p2548::shared_storage>, Functor>::run("p2548::copyable_function<shared_storage>" + suffix);
+	}
+}
+
+
+TEST_CASE("invocation", "[benchmark] [invocation]") {
+	small_functor func{1};
+	int arg{0};
+	BENCHMARK("raw template") { return invoke(func, ++arg); };
+	bench_invocation<std::function<int(int)>>("std::function<int(int)>");
+#ifdef __cpp_lib_move_only_function
+	bench_qualifiers<std::move_only_function>("std::move_only_function");
+#endif
+	bench_qualifiers<p2548::move_only_function>("p2548::move_only_function");
+	bench_qualifiers<p2548::copyable_function>("p2548::copyable_function");
+}
+
+TEST_CASE("free function invocation", "[benchmark] [invocation]") {
+	int arg{0};
+	p2548::move_only_function<int(int)> f0{&free_function};
+	BENCHMARK("p2548::move_only_function (function pointer)") { return f0(++arg); };
+	p2548::move_only_function<int(int)> f1{p2548::nontype<&free_function>};
+	BENCHMARK("p2548::move_only_function (nontype)") { return f1(++arg); };
+}
+
+TEST_CASE("dispatch loop", "[benchmark] [invocation]") {
+	bench_dispatch_loop<std::function<int(int)>>("std::function");
+#ifdef __cpp_lib_move_only_function
+	bench_dispatch_loop<std::move_only_function<int(int)>>("std::move_only_function");
+#endif
+	bench_dispatch_loop<p2548::move_only_function<int(int)>>("p2548::move_only_function");
+	bench_dispatch_loop<p2548::move_only_function<int(int), p2548::inline_dispatch>>("p2548::move_only_function<inline_dispatch>");
+	bench_dispatch_loop<p2548::copyable_function<int(int)>>("p2548::copyable_function");
+	bench_dispatch_loop<p2548::copyable_function<int(int), p2548::inline_dispatch>>("p2548::copyable_function<inline_dispatch>");
+	bench_dispatch_loop<p2548::move_only_function<int(int), p2548::compressed_vtable>>("p2548::move_only_function<compressed_vtable>");
+	bench_dispatch_loop<p2548::compact_move_only_function<int(int)>>("p2548::compact_move_only_function");
+}
+
+TEST_CASE("large argument", "[benchmark] [invocation]") {
+	const auto handler{[](message msg) noexcept { return msg.id + msg.payload[0]; }};
+	message msg{};
+	const auto bench{[&](std::string name, const auto & func) {
+		BENCHMARK(std::move(name)) {
+			++msg.id;
+			return func(msg);
+		};
+	}};
+	bench("std::function", std::function<int(message)>{handler});
+	bench("p2548::copyable_function", p2548::copyable_function<int(message) const>{handler});
+	bench("p2548::function_ref", p2548::function_ref<int(message) const>{handler});
+}
+
+TEST_CASE("small argument", "[benchmark] [invocation]") { //std::string_view opts into p2548::pass_by_value
+	const auto handler{[](std::string_view str) noexcept { return static_cast<int>(str.size()); }};
+	const std::string_view str{"some text"};
+	const auto bench{[&](std::string name, const auto & func) {
+		BENCHMARK(std::move(name)) { return func(str); };
+	}};
+	bench("std::function", std::function<int(std::string_view)>{handler});
+	bench("p2548::copyable_function", p2548::copyable_function<int(std::string_view) const>{handler});
+	bench("p2548::function_ref", p2548::function_ref<int(std::string_view) const>{handler});
+}
+
+TEST_CASE("plugin table", "[benchmark] [invocation]") {
+	const auto bench{[](std::string name, auto table) {
+		BENCHMARK(std::move(name)) {
+			int sum{0};
+			for(auto & handler : table) sum += handler(sum & 7);
+			return sum;
+		};
+	}};
+	bench("std::function", make_plugin_table<std::function<int(int)>>(std::make_integer_sequence<int, 32>{}));
+	bench("p2548::move_only_function", make_plugin_table<p2548::move_only_function<int(int)>>(std::make_integer_sequence<int, 32>{}));
+	bench("p2548::copyable_function", make_plugin_table<p2548::copyable_function<int(int)>>(std::make_integer_sequence<int, 32>{}));
+}
+
+TEST_CASE("guarded devirtualization", "[benchmark] [invocation]") {
+	std::vector<p2548::copyable_function<int(int) const>> handlers;
+	for(auto i{0}; i < 64; ++i) {
+		if(i % 8) handlers.emplace_back(small_functor{i});
+		else handlers.emplace_back(big_functor{i});
+	}
+
+	BENCHMARK("p2548::copyable_function") {
+		int sum{0};
+		for(const auto & handler : handlers) sum += handler(sum & 7);
+		return sum;
+	};
+	BENCHMARK("p2548::copyable_function (target<small_functor>)") {
+		int sum{0};
+		for(const auto & handler : handlers) {
+			if(const auto ptr{handler.target<small_functor>()}) sum += (*ptr)(sum & 7); //inlined fast path
+			else sum += handler(sum & 7);
+		}
+		return sum;
+	};
+}
+
+TEST_CASE("cached invocation", "[benchmark] [invocation]") {
+	using function = p2548::copyable_function<int(int) const>;
+	std::vector<function> handlers;
+	std::mt19937 gen{42};
+	std::uniform_int_distribution<int> dist{0, 99};
+	for(auto i{0}; i < 1024; ++i) { //95% of the handlers are of three types
+		if(const auto r{dist(gen)}; r < 50) handlers.emplace_back(small_functor{r});
+		else if(r < 80) handlers.emplace_back(big_functor{r});
+		else if(r < 95) handlers.emplace_back(&free_function);
+		else handlers.emplace_back([r](int x) { return x * r; });
+	}
+
+	BENCHMARK("p2548::copyable_function") {
+		int sum{0};
+		for(const auto & handler : handlers) sum += handler(sum & 7);
+		return sum;
+	};
+	BENCHMARK("p2548::cached_invoke") {
+		int sum{0};
+		for(const auto & handler : handlers) sum += p2548::cached_invoke<small_functor, big_functor, int(*)(int)>(handler, sum & 7);
+		return sum;
+	};
+	BENCHMARK("p2548::call_site_cache") {
+		p2548::call_site_cache<small_functor, big_functor, int(*)(int)> cache;
+		int sum{0};
+		for(const auto & handler : handlers) sum += cache(handler, sum & 7);
+		return sum;
+	};
+}
+
+TEST_CASE("reassignment", "[benchmark] [assignment]") {
+	const auto bench{[]<typename Function>(std::string name, Function func, auto assign) {
+		int i{0};
+		BENCHMARK(std::move(name)) {
+			assign(func, ++i);
+			return func(i);
+		};
+	}};
+	bench("std::function (SBO)", std::function<int(int)>{small_functor{0}}, [](auto & func, int i) { func = small_functor{i}; });
+	bench("p2548::move_only_function (SBO)", p2548::move_only_function<int(int)>{small_functor{0}}, [](auto & func, int i) { func = small_functor{i}; });
+	bench("p2548::move_only_function::emplace (SBO)", p2548::move_only_function<int(int)>{small_functor{0}}, [](auto & func, int i) { func.template emplace<small_functor>(i); });
+	bench("std::function (heap)", std::function<int(int)>{big_functor{0}}, [](auto & func, int i) { func = big_functor{i}; });
+	bench("p2548::move_only_function (heap)", p2548::move_only_function<int(int)>{big_functor{0}}, [](auto & func, int i) { func = big_functor{i}; });
+	bench("p2548::move_only_function::emplace (heap)", p2548::move_only_function<int(int)>{big_functor{0}}, [](auto & func, int i) { func.template emplace<big_functor>(i); });
+}
+
+TEST_CASE("vector growth", "[benchmark] [move]") {
+	bench_vector_growth<std::function<int(int)>>("std::function");
+	bench_vector_growth<p2548::move_only_function<int(int)>>("p2548::move_only_function");
+	bench_vector_growth<p2548::move_only_function<int(int), p2548::trivially_relocatable>>("p2548::move_only_function<trivially_relocatable>");
+	bench_vector_growth<p2548::compact_move_only_function<int(int)>>("p2548::compact_move_only_function");
+}
+
+TEST_CASE("construction", "[benchmark] [construction]") {
+	bench_wrappers<construction, small_functor>(" (SBO)");
+	bench_wrappers<construction, big_functor>(" (heap)");
+}
+
+TEST_CASE("move construction", "[benchmark] [move]") {
+	bench_wrappers<move_construction, small_functor>(" (SBO)");
+	bench_wrappers<move_construction, big_functor>(" (heap)");
+}
+
+TEST_CASE("move assignment", "[benchmark] [move]") {
+	bench_wrappers<move_assignment, small_functor>(" (SBO)");
+	bench_wrappers<move_assignment, big_functor>(" (heap)");
+}
+
+TEST_CASE("swap", "[benchmark] [swap]") {
+	bench_wrappers<swapping, small_functor>(" (SBO)");
+	bench_wrappers<swapping, big_functor>(" (heap)");
+}
+
+TEST_CASE("copy construction", "[benchmark] [copy]") {
+	bench_copyable_wrappers<copy_construction, small_functor>(" (SBO)");
+	bench_copyable_wrappers<copy_construction, big_functor>(" (heap)");
+}
+
+TEST_CASE("copy assignment", "[benchmark] [copy]") {
+	bench_copyable_wrappers<copy_assignment, small_functor>(" (SBO)");
+	bench_copyable_wrappers<copy_assignment, big_functor>(" (heap)");
+}
@@ -0,0 +1,60 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <catch.hpp>
+#include <functional>
+#include <function_ref.hpp>
+#include <copyable_function.hpp>
+
+namespace {
+	struct functor {
+		int val;
+
+		auto operator()(int x) const noexcept -> int { return val + x; }
+	};
+
+	int func(int x) noexcept { return x + 1; }
+
+	template<typename F>
+	auto call(const F & f, int arg) -> decltype(auto) { return f(arg); }
+}
+
+
+TEST_CASE("function_ref dispatch", "[benchmark] [function_ref]") {
+	functor f{1};
+	int arg{0};
+
+	BENCHMARK("raw template") { return call(f, ++arg); };
+
+	const std::function<int(int)> sf{f};
+	BENCHMARK("std::function") { return call(sf, ++arg); };
+
+#ifdef __cpp_lib_move_only_function
+	const std::move_only_function<int(int) const> smof{f};
+	BENCHMARK("std::move_only_function") { return call(smof, ++arg); };
+#endif
+
+	p2548::copyable_function<int(int) const> cf{f};
+	BENCHMARK("p2548::copyable_function") { return call(cf, ++arg); };
+
+	const p2548::function_ref<int(int) const> ref{f};
+	BENCHMARK("p2548::function_ref (functor)") { return call(ref, ++arg); };
+
+	const p2548::function_ref<int(int)> fref{func};
+	BENCHMARK("p2548::function_ref (function)") { return call(fref, ++arg); };
+
+	const p2548::function_ref<int(int)> nref{p2548::nontype<func>};
+	BENCHMARK("p2548::function_ref (nontype function)") { return call(nref, ++arg); };
+
+	const p2548::function_ref<int(int) const> mref{p2548::nontype<&functor::operator()>, f};
+	BENCHMARK("p2548::function_ref (nontype member)") { return call(mref, ++arg); };
+
+	const p2548::function_ref<int(int) const> wref{cf};
+	BENCHMARK("p2548::function_ref (copyable_function)") { return call(wref, ++arg); };
+
+	const p2548::function_ref<long(int) const> cref{cf}; //signature mismatch => dispatches through the wrapper's call operator
+	BENCHMARK("p2548::function_ref (copyable_function, converting)") { return call(cref, ++arg); };
+}
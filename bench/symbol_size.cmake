@@ -0,0 +1,42 @@
+#          Copyright Michael Florian Hava.
+# Distributed under the Boost Software License, Version 1.0.
+#    (See accompanying file ../LICENSE_1_0.txt or copy at
+#          http://www.boost.org/LICENSE_1_0.txt)
+
+# reports the number and size of the symbols generated by the type-erased wrappers
+# usage: cmake -DNM=<nm> -DSIZE=<size> -DBINARY=<executable> -P symbol_size.cmake
+
+execute_process(COMMAND ${SIZE} -A ${BINARY} OUTPUT_VARIABLE sections COMMAND_ERROR_IS_FATAL ANY)
+message("${sections}")
+
+execute_process(COMMAND ${NM} -C --print-size ${BINARY} OUTPUT_VARIABLE symbols COMMAND_ERROR_IS_FATAL ANY)
+string(REPLACE ";" "\;" symbols "${symbols}")
+string(REPLACE "\n" ";" symbols "${symbols}")
+
+foreach(category vtables dispatch managers)
+	set(${category}_count 0)
+	set(${category}_bytes 0)
+endforeach()
+
+foreach(symbol IN LISTS symbols)
+	if(NOT symbol MATCHES "^[0-9a-f]+ ([0-9a-f]+) . (.*p2548::internal_function::.*)$")
+		continue()
+	endif()
+	set(bytes "0x${CMAKE_MATCH_1}")
+	set(name "${CMAKE_MATCH_2}")
+	if(name MATCHES "::vtable$")
+		set(category vtables)
+	elseif(name MATCHES "::invoker<")
+		set(category dispatch)
+	elseif(name MATCHES "_manager<")
+		set(category managers)
+	else()
+		continue()
+	endif()
+	math(EXPR ${category}_count "${${category}_count} + 1")
+	math(EXPR ${category}_bytes "${${category}_bytes} + ${bytes}")
+endforeach()
+
+foreach(category vtables dispatch managers)
+	message("${category}: ${${category}_count} symbols, ${${category}_bytes} bytes")
+endforeach()
@@ -5,143 +5,1122 @@
 //          http://www.boost.org/LICENSE_1_0.txt)
 
 #pragma once
+#include <new>
+#include <atomic>
+#include <tuple>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
 #include <utility>
+#include <typeinfo>
 #include <functional>
 #include <type_traits>
+#include "nontype.hpp"
+#include "function_ref.hpp"
 
 namespace p2548 {
 	//! @brief move-only function wrapper
-	//! @tparam Signature function signature of the contained functor (including potential const-, ref- and noexcept-qualifiers)
+	//! @tparam Signature one or more function signatures of the contained functor (including potential const-, ref- and noexcept-qualifiers), optionally followed by policies (e.g. inline_capacity)
 	template<typename... Signature>
 	class move_only_function;
 
 
 	//! @brief copyable function wrapper
-	//! @tparam Signature function signature of the contained functor (including potential const-, ref- and noexcept-qualifiers)
+	//! @tparam Signature one or more function signatures of the contained functor (including potential const-, ref- and noexcept-qualifiers), optionally followed by policies (e.g. inline_capacity)
 	template<typename... Signature>
 	class copyable_function;
 
 
+	//! @brief move-only function wrapper occupying a single pointer, for large tables of callbacks that rarely fit an inline buffer
+	//! @tparam Signature one or more function signatures of the contained functor (including potential const-, ref- and noexcept-qualifiers)
+	//! @note the vtable is stored in front of the heap-allocated functor, empty wrappers, function pointers and stateless functors are encoded without allocating
+	template<typename... Signature>
+	class compact_move_only_function;
+
+
+	//! @brief policy to configure the size of the inline buffer of owning function wrappers
+	//! @tparam Size number of bytes available to store functors without allocating
+	template<std::size_t Size>
+	struct inline_capacity final {};
+
+
+	//! @brief policy to grow the inline buffer of owning function wrappers so that a std::function can be stored without allocating
+	//! @note eases migrating from std::function, as converting it to a wrapper no longer allocates
+	struct std_function_capacity final {};
+
+
+	//! @brief policy to configure the alignment of the inline buffer of owning function wrappers
+	//! @tparam Align alignment guaranteed for functors stored without allocating (e.g. to store functors capturing SIMD vectors inline)
+	template<std::size_t Align>
+	struct inline_alignment final {
+		static_assert(Align != 0 && (Align & (Align - 1)) == 0, "alignment must be a power of two");
+	};
+
+
+	//! @brief policy for copyable_function to share heap-allocated functors between copies
+	//! @note copies only increment a reference count, the functor is cloned when it is invoked through a non-const signature while shared
+	//! @note with noexcept non-const signatures only nothrow copy constructible functors are accepted, a failing allocation of the clone still calls std::terminate
+	struct shared_storage final {};
+
+
+	//! @brief policy to store the dispatch function pointer in the wrapper itself
+	//! @note trades an additional pointer per wrapper for one indirection less per invocation
+	struct inline_dispatch final {};
+
+
+	//! @brief policy to store a 32-bit index into a registry of vtables instead of the vtable pointer, growing the inline buffer by the bytes saved
+	//! @note trades one indirection more per invocation for a larger inline buffer, indices are only valid within the binary that registered the vtable
+	struct compressed_vtable final {};
+
+
+	//! @brief policy to restrict owning function wrappers to functors that are stored inline and relocatable by copying their bytes
+	//! @note the wrapper itself becomes trivially copyable, so containers may relocate it with memcpy/memmove; moved-from wrappers retain their target
+	struct trivially_relocatable final {};
+
+
+	//! @brief policy to restrict owning function wrappers to functors that are stored inline, ruling out any allocation by the wrapper
+	//! @note functors exceeding the inline buffer are rejected at compile time, use stores_inline_v to check ahead of time
+	struct inplace_only final {};
+
+
+	//! @brief policy to make owning function wrappers non-movable, allowing them to store functors inline regardless of their move constructor
+	//! @note intended for wrappers at a fixed address (e.g. members of long-lived objects), targets are replaced with emplace or by assigning nullptr
+	struct pinned final {};
+
+
+	//! @brief trait to detect functors whose destructive move is equivalent to copying their object representation
+	//! @note may be specialized for user-defined types
+	template<typename T>
+#if defined(__has_builtin)
+#if __has_builtin(__is_trivially_relocatable)
+	struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T> || __is_trivially_relocatable(T)> {};
+#else
+	struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+#endif
+#else
+	struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+#endif
+
+	template<typename T>
+	inline
+	constexpr
+	bool is_trivially_relocatable_v{is_trivially_relocatable<T>::value};
+
+
 	namespace internal_function {
-		union storage_t {
+		enum class layout { pointer, fat_pointer, index, };
+
+
+		template<std::size_t Size, std::size_t Align = alignof(void *), bool Pinned = false, bool Packed = false>
+		union alignas(void *) alignas(Align) storage_t {
+			static
+			constexpr
+			std::size_t size{Size};
+
+			static
+			constexpr
+			std::size_t alignment{Align > alignof(void *) ? Align : alignof(void *)};
+
+			static
+			constexpr
+			bool pinned{Pinned}; //the storage is never relocated
+
+			static
+			constexpr
+			bool packed{Packed}; //the storage is followed by a vtable index
+
 			void * ptr;
-			char sbo[sizeof(void * ) * 3];
+			char sbo[Size];
+		};
+
+		//! @brief storage without tail padding, so that a vtable index can follow it
+		//! @note the storage must be declared with alignas(alignment), which guarantees the alignment of its members despite the packing
+#pragma pack(push, 4)
+		template<std::size_t Size, std::size_t Align, bool Pinned>
+		union storage_t<Size, Align, Pinned, true> {
+			static
+			constexpr
+			std::size_t size{Size};
+
+			static
+			constexpr
+			std::size_t alignment{Align > alignof(void *) ? Align : alignof(void *)};
+
+			static
+			constexpr
+			bool pinned{Pinned};
+
+			static
+			constexpr
+			bool packed{true};
+
+			void * ptr;
+			char sbo[Size];
+		};
+#pragma pack(pop)
+
+
+		struct default_options {
+			static
+			constexpr
+			std::size_t capacity{sizeof(void *) * 3};
+
+			static
+			constexpr
+			std::size_t alignment{alignof(void *)};
+
+			static
+			constexpr
+			bool shared{false};
+
+			static
+			constexpr
+			layout vtable_layout{layout::pointer};
+
+			static
+			constexpr
+			bool trivial{false};
+
+			static
+			constexpr
+			bool inplace{false};
+
+			static
+			constexpr
+			bool pinned{false};
+		};
+
+		template<typename Options, typename Policy>
+		struct apply_policy;
+
+		template<typename Options, std::size_t Size>
+		struct apply_policy<Options, inline_capacity<Size>> : Options {
+			static
+			constexpr
+			std::size_t capacity{Size};
+		};
+
+		template<typename Options, std::size_t Align>
+		struct apply_policy<Options, inline_alignment<Align>> : Options {
+			static
+			constexpr
+			std::size_t alignment{Align};
+		};
+
+		template<typename Options>
+		struct apply_policy<Options, std_function_capacity> : Options {
+			static
+			constexpr
+			std::size_t capacity{Options::capacity < sizeof(std::function<void()>) ? sizeof(std::function<void()>) : Options::capacity};
+		};
+
+		template<typename Options>
+		struct apply_policy<Options, shared_storage> : Options {
+			static
+			constexpr
+			bool shared{true};
+		};
+
+		template<typename Options>
+		struct apply_policy<Options, inline_dispatch> : Options {
+			static_assert(Options::vtable_layout != layout::index, "inline_dispatch and compressed_vtable are mutually exclusive");
+
+			static
+			constexpr
+			layout vtable_layout{layout::fat_pointer};
+		};
+
+		template<typename Options>
+		struct apply_policy<Options, compressed_vtable> : Options {
+			static_assert(Options::vtable_layout != layout::fat_pointer, "inline_dispatch and compressed_vtable are mutually exclusive");
+
+			static
+			constexpr
+			layout vtable_layout{layout::index};
+		};
+
+		template<typename Options>
+		struct apply_policy<Options, trivially_relocatable> : Options {
+			static
+			constexpr
+			bool trivial{true};
+		};
+
+		template<typename Options>
+		struct apply_policy<Options, inplace_only> : Options {
+			static
+			constexpr
+			bool inplace{true};
+		};
+
+		template<typename Options>
+		struct apply_policy<Options, pinned> : Options {
+			static
+			constexpr
+			bool pinned{true};
+		};
+
+		template<typename Options, typename... Policies>
+		struct make_options { using type = Options; };
+
+		template<typename Options, typename Policy, typename... Policies>
+		struct make_options<Options, Policy, Policies...> : make_options<apply_policy<Options, Policy>, Policies...> {};
+
+		template<typename... Policies>
+		using options_t = typename make_options<default_options, Policies...>::type;
+
+
+		enum class capability : unsigned char {
+			none                   = 0,
+			trivially_destructible = 1 << 0, //destroy is a no-op
+			trivially_relocatable  = 1 << 1, //destructive move is a copy of the storage
+			nothrow_copyable       = 1 << 2,
+			heap_allocated         = 1 << 3, //storage only holds a pointer to the functor
+			shared_ownership       = 1 << 4, //storage holds a pointer to a reference-counted block containing the functor
+			stateless              = 1 << 5, //storage holds no bytes worth copying (empty wrappers and empty trivially copyable functors leave it uninitialized)
+			throwing_unshare       = 1 << 6, //cloning the shared functor may throw
+		};
+
+		constexpr
+		auto operator|(capability lhs, capability rhs) noexcept -> capability { return static_cast<capability>(std::to_underlying(lhs) | std::to_underlying(rhs)); }
+
+		constexpr
+		auto has(capability set, capability flag) noexcept -> bool { return (std::to_underlying(set) & std::to_underlying(flag)) != 0; }
+
+		constexpr
+		auto flag_if(bool condition, capability flag) noexcept -> capability { return condition ? flag : capability::none; }
+
+
+		//! @brief identity of a target type, compared by address so that querying the target requires no RTTI
+		struct type_tag final {
+#if defined(__cpp_rtti) || defined(__GXX_RTTI) || defined(_CPPRTTI)
+			const std::type_info & info;
+#endif
+		};
+
+		template<typename T>
+		inline
+		constexpr
+#if defined(__cpp_rtti) || defined(__GXX_RTTI) || defined(_CPPRTTI)
+		type_tag type_tag_v{typeid(T)};
+#else
+		type_tag type_tag_v{};
+#endif
+
+
+		template<typename T, typename Storage>
+		inline
+		constexpr
+		bool sbo{sizeof(T) <= Storage::size && alignof(T) <= Storage::alignment && (Storage::pinned || std::is_nothrow_move_constructible_v<T>)};
+
+		template<typename T, typename Storage, typename Options>
+		constexpr
+		auto storable() noexcept -> bool {
+			if constexpr(Options::trivial) return sbo<T, Storage> && std::is_trivially_copyable_v<T>;
+			else if constexpr(Options::inplace) return sbo<T, Storage>;
+			else return true;
+		}
+
+		template<typename T, typename Storage, typename Options>
+		inline
+		constexpr
+		bool is_storable{storable<T, Storage, Options>()};
+
+
+		//! @note P2548_POOLED_ALLOCATION serves heap-allocated targets from the pool, blocks are cached by the thread freeing them without a return path to the allocating thread
+		//! @note if targets are created on one thread and destroyed on another (e.g. handing tasks to a worker) the creating thread falls back to ::operator new
+#if defined(P2548_POOLED_ALLOCATION)
+		inline
+		constexpr
+		bool pooled_allocation{true};
+#else
+		inline
+		constexpr
+		bool pooled_allocation{false};
+#endif
+
+
+		//! @brief size-class pool with per-thread free lists
+		//! @note deallocation caches the block on the calling thread (up to max_cached per class), regardless of the thread that allocated it
+		class pool final {
+			static
+			constexpr
+			std::size_t classes{4}, min_size{32}, max_cached{256};
+
+			struct node { node * next; };
+
+			struct free_lists final {
+				node * heads[classes];
+				std::size_t counts[classes];
+				bool released;
+			};
+
+			struct releaser final {
+				~releaser() noexcept {
+					auto & lists{local()};
+					for(std::size_t i{0}; i < classes; ++i)
+						while(lists.heads[i]) ::operator delete(std::exchange(lists.heads[i], lists.heads[i]->next), size_of(i));
+					lists.released = true;
+				}
+			};
+
+			static
+			auto local() noexcept -> free_lists & {
+				thread_local constinit free_lists lists{}; //trivially destructible => remains usable during thread teardown
+				return lists;
+			}
+
+			static
+			constexpr
+			auto index_of(std::size_t size) noexcept -> std::size_t {
+				std::size_t index{0};
+				while((min_size << index) < size) ++index;
+				return index;
+			}
+
+			static
+			constexpr
+			auto size_of(std::size_t index) noexcept -> std::size_t { return min_size << index; }
+		public:
+			static
+			constexpr
+			std::size_t max_size{min_size << (classes - 1)};
+
+			static
+			constexpr
+			auto supports(std::size_t size, std::size_t alignment) noexcept -> bool { return size <= max_size && alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__; }
+
+			static
+			constexpr
+			auto class_size(std::size_t size) noexcept -> std::size_t { return size_of(index_of(size)); }
+
+			static
+			auto allocate(std::size_t size) -> void * {
+				//PRECONDITION: size <= max_size
+				const auto index{index_of(size)};
+				auto & lists{local()};
+				if(!lists.heads[index]) return ::operator new(size_of(index));
+				--lists.counts[index];
+				return std::exchange(lists.heads[index], lists.heads[index]->next);
+			}
+
+			static
+			void deallocate(void * ptr, std::size_t size) noexcept {
+				//PRECONDITION: ptr was obtained from allocate(size)
+				const auto index{index_of(size)};
+				auto & lists{local()};
+				if(lists.released || lists.counts[index] == max_cached) return ::operator delete(ptr, size_of(index));
+				thread_local releaser r;
+				lists.heads[index] = new(ptr) node{lists.heads[index]};
+				++lists.counts[index];
+			}
+		};
+
+
+		//! @brief allocation class of a heap block, blocks of the same class are allocated and deallocated alike
+		struct block_class final {
+			std::size_t size, alignment;
+
+			friend
+			constexpr
+			auto operator==(const block_class &, const block_class &) noexcept -> bool =default;
+		};
+
+
+		template<typename T, typename Alloc>
+		class heap final {
+			//layout of a block: [T][padding][Alloc]
+			static
+			constexpr
+			std::size_t offset{(sizeof(T) + alignof(Alloc) - 1) / alignof(Alloc) * alignof(Alloc)};
+
+			static
+			constexpr
+			std::size_t alignment{alignof(T) > alignof(Alloc) ? alignof(T) : alignof(Alloc)};
+
+			struct alignas(alignment) unit { std::byte bytes[alignment]; };
+
+			static
+			constexpr
+			std::size_t count{(offset + sizeof(Alloc) + sizeof(unit) - 1) / sizeof(unit)};
+
+			using allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<unit>;
+			using traits = std::allocator_traits<allocator>;
+
+			static
+			auto stored(const T * ptr) noexcept -> Alloc & { return *std::launder(reinterpret_cast<Alloc *>(reinterpret_cast<std::byte *>(const_cast<T *>(ptr)) + offset)); }
+		public:
+			template<typename... A>
+			static
+			auto create(const Alloc & alloc, A &&... args) -> T * {
+				allocator a{alloc};
+				const auto block{traits::allocate(a, count)};
+				const auto bytes{reinterpret_cast<std::byte *>(std::to_address(block))};
+				T * ptr;
+				try {
+					ptr = new(bytes) T{std::forward<A>(args)...};
+				} catch(...) {
+					traits::deallocate(a, block, count);
+					throw;
+				}
+				new(bytes + offset) Alloc{alloc};
+				return ptr;
+			}
+
+			static
+			auto copy(const T * ptr) -> T * { return create(stored(ptr), *ptr); }
+
+			static
+			void destroy(T * ptr) noexcept {
+				auto & alloc{stored(ptr)};
+				allocator a{alloc};
+				alloc.~Alloc();
+				ptr->~T();
+				traits::deallocate(a, std::pointer_traits<typename traits::pointer>::pointer_to(*reinterpret_cast<unit *>(ptr)), count);
+			}
+		};
+
+		template<typename T>
+		class heap<T, void> final {
+			static
+			constexpr
+			bool pooled{pooled_allocation && pool::supports(sizeof(T), alignof(T))};
+
+			static
+			constexpr
+			bool overaligned{alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__};
+
+			static
+			auto allocate() -> void * {
+				if constexpr(pooled) return pool::allocate(sizeof(T));
+				else if constexpr(overaligned) return ::operator new(sizeof(T), std::align_val_t{alignof(T)});
+				else return ::operator new(sizeof(T));
+			}
+
+			static
+			void deallocate(void * ptr) noexcept {
+				if constexpr(pooled) pool::deallocate(ptr, sizeof(T));
+				else if constexpr(overaligned) ::operator delete(ptr, sizeof(T), std::align_val_t{alignof(T)});
+				else ::operator delete(ptr, sizeof(T));
+			}
+		public:
+			static
+			constexpr
+			block_class block{pooled ? pool::class_size(sizeof(T)) : sizeof(T), overaligned ? alignof(T) : 0};
+
+			template<typename... A>
+			static
+			auto create(A &&... args) -> T * { return create_at(allocate(), std::forward<A>(args)...); }
+
+			//! @brief constructs into a block of the same class, which is deallocated if the construction throws
+			template<typename... A>
+			static
+			auto create_at(void * ptr, A &&... args) -> T * {
+				try {
+					return new(ptr) T{std::forward<A>(args)...};
+				} catch(...) {
+					deallocate(ptr);
+					throw;
+				}
+			}
+
+			static
+			auto copy(const T * ptr) -> T * { return create(*ptr); }
+
+			static
+			void destroy(T * ptr) noexcept {
+				ptr->~T();
+				deallocate(ptr);
+			}
+
+			//! @brief destroys the object, but retains its block
+			static
+			auto recycle(T * ptr) noexcept -> void * {
+				ptr->~T();
+				return ptr;
+			}
+		};
+
+
+		template<typename T>
+		struct shared_block final {
+			std::atomic<std::size_t> count{1};
+			T value;
+
+			template<typename... A>
+			explicit
+			shared_block(A &&... args) : value{std::forward<A>(args)...} {}
+
+			shared_block(const shared_block & other) : value{other.value} {}
+
+			auto unique() const noexcept -> bool { return count.load(std::memory_order_acquire) == 1; }
+
+			static
+			auto acquire(shared_block * self) noexcept -> shared_block * {
+				self->count.fetch_add(1, std::memory_order_relaxed);
+				return self;
+			}
+
+			template<typename Alloc>
+			static
+			void release(shared_block * self) noexcept { if(self->count.fetch_sub(1, std::memory_order_acq_rel) == 1) heap<shared_block, Alloc>::destroy(self); }
+
+			template<typename Alloc>
+			static
+			auto unshare(void *& ptr) -> shared_block * {
+				auto self{static_cast<shared_block *>(ptr)};
+				if(!self->unique()) {
+					const auto clone{heap<shared_block, Alloc>::copy(self)};
+					release<Alloc>(self);
+					ptr = self = clone;
+				}
+				return self;
+			}
+		};
+
+
+		//! @brief header of the heap block of a compact wrapper, allowing the wrapper to consist of a single pointer
+		struct compact_header {
+			const void * vtable; //compact_vtable of the functor
+		};
+
+		template<typename T>
+		struct compact_block final : compact_header {
+			T value;
+
+			template<typename... A>
+			constexpr
+			explicit
+			compact_block(const void * vtable, A &&... args) : compact_header{vtable}, value{std::forward<A>(args)...} {}
+		};
+
+
+		template<bool Copyable, typename T, typename Storage, typename Alloc = void>
+		struct owning_manager final {
+			static
+			constexpr
+			bool copyable{Copyable};
+
+			static
+			constexpr
+			bool bytewise_copyable{sbo<T, Storage> && std::is_trivially_copyable_v<T>};
+
+			static
+			constexpr
+			capability capabilities{sbo<T, Storage>
+				? flag_if(std::is_trivially_destructible_v<T>, capability::trivially_destructible) | flag_if(is_trivially_relocatable_v<T>, capability::trivially_relocatable) | flag_if(std::is_nothrow_copy_constructible_v<T>, capability::nothrow_copyable) | flag_if(std::is_empty_v<T> && std::is_trivially_copyable_v<T>, capability::stateless)
+				: capability::trivially_relocatable | capability::heap_allocated
+			};
+
+			static
+			void destroy(Storage * self) noexcept {
+				if constexpr(sbo<T, Storage>) reinterpret_cast<T *>(self->sbo)->~T();
+				else heap<T, Alloc>::destroy(reinterpret_cast<T *>(self->ptr));
+			}
+
+			static
+			void relocate(Storage * from, Storage * to) noexcept {
+				//PRECONDITION: sbo<T, Storage>
+				new(to->sbo) T{std::move(*reinterpret_cast<T *>(from->sbo))};
+				reinterpret_cast<T *>(from->sbo)->~T();
+			}
+
+			static
+			void copy(const Storage * from, Storage * to) {
+				if constexpr(sbo<T, Storage>) new(to->sbo) T{*reinterpret_cast<const T *>(from->sbo)};
+				else to->ptr = heap<T, Alloc>::copy(reinterpret_cast<const T *>(from->ptr));
+			}
+
+			//! @brief heap-allocated targets of the same type can be assigned without reallocating, retaining the strong exception guarantee
+			static
+			constexpr
+			bool reassignable{Copyable && !sbo<T, Storage> && (std::is_nothrow_copy_assignable_v<T> || std::is_nothrow_move_assignable_v<T>)};
+
+			static
+			void assign(const Storage * from, Storage * to) {
+				//PRECONDITION: reassignable
+				auto & target{*reinterpret_cast<T *>(to->ptr)};
+				const auto & source{*reinterpret_cast<const T *>(from->ptr)};
+				if constexpr(std::is_nothrow_copy_assignable_v<T>) target = source;
+				else {
+					T tmp{source};
+					target = std::move(tmp);
+				}
+			}
+
+			//! @brief heap-allocated targets without allocator can hand over their block to a new target of the same block class
+			static
+			constexpr
+			bool recyclable{!sbo<T, Storage> && std::is_void_v<Alloc>};
+
+			static
+			auto recycle(Storage * self, block_class block) noexcept -> void * {
+				//PRECONDITION: recyclable
+				const auto ptr{reinterpret_cast<T *>(self->ptr)};
+				if(heap<T, void>::block == block) return heap<T, void>::recycle(ptr);
+				heap<T, void>::destroy(ptr);
+				return nullptr;
+			}
+		};
+
+
+		template<typename T, typename Storage, typename Alloc = void>
+		struct shared_manager final {
+			static
+			constexpr
+			bool copyable{true};
+
+			static
+			constexpr
+			bool bytewise_copyable{false};
+
+			static
+			constexpr
+			capability capabilities{capability::trivially_relocatable | capability::nothrow_copyable | capability::heap_allocated | capability::shared_ownership | flag_if(!std::is_nothrow_copy_constructible_v<T>, capability::throwing_unshare)};
+
+			static
+			void destroy(Storage * self) noexcept { shared_block<T>::template release<Alloc>(static_cast<shared_block<T> *>(self->ptr)); }
+
+			static
+			void copy(const Storage * from, Storage * to) noexcept { to->ptr = shared_block<T>::acquire(static_cast<shared_block<T> *>(from->ptr)); }
+
+			static
+			constexpr
+			bool reassignable{false};
+
+			static
+			constexpr
+			bool recyclable{false};
+
+			static
+			void unshare(Storage * self) { shared_block<T>::template unshare<Alloc>(self->ptr); }
+		};
+
+
+		//! @brief manager for empty wrappers and for targets that are encoded in the dispatch function itself
+		struct stateless_manager final {
+			static
+			constexpr
+			bool copyable{false};
+
+			static
+			constexpr
+			bool bytewise_copyable{true};
+
+			static
+			constexpr
+			capability capabilities{capability::trivially_destructible | capability::trivially_relocatable | capability::nothrow_copyable | capability::stateless};
+
+			static
+			constexpr
+			bool reassignable{false};
+
+			static
+			constexpr
+			bool recyclable{false};
+		};
+
+
+		template<bool Copyable, typename T, typename Storage, typename... A>
+		void construct(Storage & storage, A &&... args) {
+			if constexpr(Copyable) static_assert(std::is_copy_constructible_v<T>);
+			//PRECONDITION: std::is_nothrow_destructible_v<T>
+
+			if constexpr(sbo<T, Storage>) new(storage.sbo) T{std::forward<A>(args)...};
+			else storage.ptr = heap<T, void>::create(std::forward<A>(args)...);
+		}
+
+
+		//! @brief function pointers that convert to the plain function pointer of the signature share one vtable and dispatch function
+		template<typename Traits, typename T>
+		struct canonical_target final { using type = T; };
+
+		template<typename Traits, typename T>
+		requires(std::is_pointer_v<T> && std::is_function_v<std::remove_pointer_t<T>> && requires { typename Traits::function_pointer; })
+		struct canonical_target<Traits, T> final { using type = std::conditional_t<std::is_convertible_v<T, typename Traits::function_pointer>, typename Traits::function_pointer, T>; };
+
+
+		//! @brief registry of the vtables referenced by index, indices are assigned on first use and never reused
+		class vtable_registry final {
+			static
+			constexpr
+			std::size_t capacity{std::size_t{1} << 16};
+
+			static
+			inline
+			constinit
+			std::atomic<std::uint32_t> count{1}; //0 denotes an unregistered vtable
+
+			static
+			inline
+			constinit
+			const void * entries[capacity]{}; //zero-initialized, so pages are only touched as vtables are registered
+		public:
+			static
+			auto add(const void * vtable) noexcept -> std::uint32_t {
+				const auto index{count.fetch_add(1, std::memory_order_relaxed)};
+				if(index >= capacity) std::terminate(); //more distinct vtables than the registry can hold
+				entries[index] = vtable; //published by the release of the first thread storing the index
+				return index;
+			}
+
+			static
+			auto get(std::uint32_t index) noexcept -> const void * { return entries[index]; }
+		};
+
+		//! @brief lazily assigned index in the vtable_registry of the vtable built from Manager and T (Key identifies its dispatch)
+		//! @note kept outside of the vtables, which thereby remain true constants the optimizer can fold
+		template<typename VTable, typename Manager, typename T, typename... Key>
+		inline
+		constinit
+		std::uint32_t registry_index{0};
+
+		//! @brief placeholder for the index of vtables that are never referenced by index
+		struct unregistered final {};
+
+		inline
+		auto registered_index(std::uint32_t & index, const void * vtable) noexcept -> std::uint32_t {
+			std::atomic_ref<std::uint32_t> ref{index};
+			if(const auto result{ref.load(std::memory_order_acquire)}) return result;
+			auto expected{std::uint32_t{0}};
+			const auto result{vtable_registry::add(vtable)};
+			if(ref.compare_exchange_strong(expected, result, std::memory_order_acq_rel)) return result;
+			return expected; //registered concurrently, the slot of this call remains unused
+		}
+
+
+		//! @note keyed on the erased dispatch type, so wrappers differing only in qualifiers or policies can share vtables
+		template<typename Dispatch, typename Storage>
+		struct vtable final {
+			using storage_t = Storage;
+			using dispatch_type = Dispatch;
+
+			Dispatch dispatch;
+			capability capabilities;
+			const type_tag * type;                                    //identity of the stored target
+			void (*destroy)(storage_t *) noexcept;                    //nullptr if trivially destructible
+			void (*relocate)(storage_t *, storage_t *) noexcept;      //nullptr if trivially relocatable
+			void (*clone)(const storage_t *, storage_t *);            //nullptr if not copyable or the storage can be copied bytewise
+			void (*unshare)(storage_t *);                             //nullptr if not shared
+			void (*assign)(const storage_t *, storage_t *);           //nullptr if targets of the same type cannot be assigned in place
+			void * (*recycle)(storage_t *, block_class) noexcept;     //nullptr if the target does not own a reusable heap block
+			[[no_unique_address]]
+			std::conditional_t<storage_t::packed, std::uint32_t *, unregistered> index; //index in the vtable_registry, assigned on first use (only referenced by packed storage)
+
+			auto registered_index() const noexcept -> std::uint32_t { return internal_function::registered_index(*index, this); }
+
+			auto has(capability flag) const noexcept -> bool { return internal_function::has(capabilities, flag); }
+
+			void dtor(storage_t * self) const noexcept { if(!has(capability::trivially_destructible)) destroy(self); }
+			void destructive_move(storage_t * from, storage_t * to) const noexcept {
+				if(has(capability::trivially_relocatable)) {
+					if(!has(capability::stateless)) std::memcpy(to, from, sizeof(storage_t));
+				} else relocate(from, to);
+			}
+			void copy(const storage_t * from, storage_t * to) const {
+				if(clone) clone(from, to);
+				else if(!has(capability::stateless)) std::memcpy(to, from, sizeof(storage_t));
+			}
+			auto noexcept_copyable() const noexcept -> bool { return has(capability::nothrow_copyable); }
+
+			template<typename T>
+			auto target(const storage_t * self) const noexcept -> const T * {
+				if(type != &type_tag_v<T>) return nullptr;
+				if constexpr(sbo<T, storage_t>) return std::launder(reinterpret_cast<const T *>(self->sbo)); //all managers store such targets inline
+				else {
+					if(has(capability::shared_ownership)) return &static_cast<const shared_block<T> *>(self->ptr)->value;
+					return static_cast<const T *>(self->ptr);
+				}
+			}
+			template<typename T>
+			auto target(storage_t * self) const -> T * {
+				if(type != &type_tag_v<T>) return nullptr;
+				if constexpr(!sbo<T, storage_t>) if(unshare) unshare(self); //copy-on-write, as the target may be modified
+				return const_cast<T *>(target<T>(static_cast<const storage_t *>(self)));
+			}
+
+			template<typename Manager, typename T, typename... Key>
+			static
+			constexpr
+			auto make(Dispatch dispatch) noexcept -> vtable {
+				constexpr auto caps{Manager::capabilities};
+				vtable result{dispatch, caps, &type_tag_v<T>, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, {}};
+				if constexpr(storage_t::packed) result.index = &registry_index<vtable, Manager, T, Key...>;
+				if constexpr(!internal_function::has(caps, capability::trivially_destructible)) result.destroy = &Manager::destroy;
+				if constexpr(!internal_function::has(caps, capability::trivially_relocatable) && !storage_t::pinned) result.relocate = &Manager::relocate;
+				if constexpr(Manager::copyable && !Manager::bytewise_copyable) result.clone = &Manager::copy;
+				if constexpr(internal_function::has(caps, capability::shared_ownership)) result.unshare = &Manager::unshare;
+				if constexpr(Manager::reassignable) result.assign = &Manager::assign;
+				if constexpr(Manager::recyclable) result.recycle = &Manager::recycle;
+				return result;
+			}
+
+			template<typename Ref>
+			static
+			void move_ctor(Ref & lhs_vptr, storage_t & lhs_storage, Ref & rhs_vptr, storage_t & rhs_storage) noexcept {
+				lhs_vptr = rhs_vptr;
+				rhs_vptr->destructive_move(&rhs_storage, &lhs_storage);
+				rhs_vptr = vtable::init_empty();
+			}
+
+			template<typename Ref>
+			static
+			void move_assign(Ref & lhs_vptr, storage_t & lhs_storage, Ref & rhs_vptr, storage_t & rhs_storage) noexcept {
+				if(&lhs_storage == &rhs_storage) return;
+
+				lhs_vptr->dtor(&lhs_storage);
+				lhs_vptr = rhs_vptr;
+				rhs_vptr->destructive_move(&rhs_storage, &lhs_storage);
+				rhs_vptr = vtable::init_empty();
+			}
+
+			template<typename Ref>
+			static
+			void swap(Ref & lhs_vptr, storage_t & lhs_storage, Ref & rhs_vptr, storage_t & rhs_storage) noexcept {
+				if(&lhs_storage == &rhs_storage) return;
+
+				alignas(storage_t::alignment) storage_t tmp;
+				lhs_vptr->destructive_move(&lhs_storage, &tmp);
+				rhs_vptr->destructive_move(&rhs_storage, &lhs_storage);
+				lhs_vptr->destructive_move(&tmp, &rhs_storage);
+				std::swap(lhs_vptr, rhs_vptr);
+			}
+
+			static
+			auto init_empty() noexcept -> const vtable * {
+				static constexpr vtable vtable{make<stateless_manager, void>({})};
+				return &vtable;
+			}
 		};
 
+		template<typename Traits, typename Storage>
+		struct vtable_factory final {
+			using vtable = internal_function::vtable<typename Traits::erased_dispatch_type, Storage>;
+			using storage_t = Storage;
 
-		enum class mode { dtor, destructive_move, copy, copy_is_nothrow, };
+			template<typename Manager, typename T, typename... Key>
+			static
+			constexpr
+			auto make(typename vtable::dispatch_type dispatch) noexcept -> vtable { return vtable::template make<Manager, T, Traits, Key...>(dispatch); }
+
+			template<bool Copyable, typename T, typename Alloc = void>
+			static
+			auto functor_vtable() noexcept -> const vtable * {
+				static constexpr vtable vtable{make<owning_manager<Copyable, T, storage_t, Alloc>, T>(Traits::template functor_dispatch<storage_t, T, sbo<T, storage_t>>)};
+				return &vtable;
+			}
+
+			template<bool Copyable, typename T, typename... A>
+			static
+			auto init_functor(storage_t & storage, A &&... args) -> const vtable * {
+				using U = typename canonical_target<Traits, T>::type;
+				construct<Copyable, U>(storage, std::forward<A>(args)...);
+				return functor_vtable<Copyable, U>();
+			}
+
+			//! @brief replaces the target described by old, constructing into its heap block if it is of the same class
+			template<bool Copyable, typename T, typename... A>
+			static
+			auto reinit_functor(const vtable & old, storage_t & storage, A &&... args) -> const vtable * {
+				using U = typename canonical_target<Traits, T>::type;
+				if constexpr(Copyable) static_assert(std::is_copy_constructible_v<U>);
+				if constexpr(!sbo<U, storage_t>)
+					if(old.recycle) {
+						if(const auto block{old.recycle(&storage, heap<U, void>::block)}) {
+							storage.ptr = heap<U, void>::create_at(block, std::forward<A>(args)...);
+							return functor_vtable<Copyable, U>();
+						}
+						return init_functor<Copyable, U>(storage, std::forward<A>(args)...);
+					}
+				old.dtor(&storage);
+				return init_functor<Copyable, U>(storage, std::forward<A>(args)...);
+			}
+
+			template<bool Copyable, typename T, typename Alloc, typename... A>
+			static
+			auto init_allocated_functor(storage_t & storage, const Alloc & alloc, A &&... args) -> const vtable * {
+				if constexpr(sbo<T, storage_t>) return init_functor<Copyable, T>(storage, std::forward<A>(args)...); //allocator is not needed for inline storage
+				else {
+					if constexpr(Copyable) static_assert(std::is_copy_constructible_v<T>);
+					using byte_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<std::byte>;
+					storage.ptr = heap<T, byte_alloc>::create(byte_alloc{alloc}, std::forward<A>(args)...);
+					return functor_vtable<Copyable, T, byte_alloc>();
+				}
+			}
+
+			template<auto F>
+			static
+			auto init_nontype(storage_t & storage) noexcept -> const vtable * {
+				new(storage.sbo) nontype_t<F>{}; //materialize the (empty) target for target()
+				static constexpr vtable vtable{make<stateless_manager, nontype_t<F>>(Traits::template nontype_dispatch<storage_t, F>)};
+				return &vtable;
+			}
+
+			template<bool Copyable, auto F, typename T, typename... A>
+			static
+			auto init_bound(storage_t & storage, A &&... args) -> const vtable * {
+				construct<Copyable, T>(storage, std::forward<A>(args)...);
+				static constexpr vtable vtable{make<owning_manager<Copyable, T, storage_t>, T, nontype_t<F>>(Traits::template bound_dispatch<storage_t, F, T, sbo<T, storage_t>>)};
+				return &vtable;
+			}
 
+			template<typename T, typename Alloc = void>
+			static
+			auto shared_vtable() noexcept -> const vtable * {
+				static constexpr vtable vtable{make<shared_manager<T, storage_t, Alloc>, T>(Traits::template shared_dispatch<storage_t, T, Alloc>)};
+				return &vtable;
+			}
 
-		template<typename T>
-		inline
-		constexpr
-		bool sbo{sizeof(T) <= sizeof(storage_t::sbo) && std::is_nothrow_move_constructible_v<T>};
-
-
-		template<bool Copyable, typename T>
-		auto owning_manage(storage_t * from, storage_t * to, mode m) -> bool {
-			if constexpr(sbo<T>) {
-				switch(m) {
-					case mode::copy:
-						if constexpr(Copyable) new(to->sbo) T{*reinterpret_cast<const T *>(from->sbo)};
-						else std::unreachable();
-						break;
-					case mode::destructive_move:
-						new(to->sbo) T{std::move(*reinterpret_cast<T *>(from->sbo))};
-						[[fallthrough]];
-					case mode::dtor:
-						reinterpret_cast<T *>(from->sbo)->~T();
-						break;
-					case mode::copy_is_nothrow: /*nop*/ break;
-				}
-				return std::is_nothrow_copy_constructible_v<T>;
-			} else {
-				switch(m) {
-					case mode::dtor:
-						delete reinterpret_cast<T *>(from->ptr);
-						break;
-					case mode::destructive_move:
-						to->ptr = std::exchange(from->ptr, nullptr);
-						break;
-					case mode::copy:
-						if constexpr(Copyable) to->ptr = new T{*reinterpret_cast<const T *>(from->ptr)};
-						else std::unreachable();
-						break;
-					case mode::copy_is_nothrow: /*nop*/ break;
+			template<typename T, typename... A>
+			static
+			auto init_shared_functor(storage_t & storage, A &&... args) -> const vtable * {
+				if constexpr(sbo<T, storage_t>) return init_functor<true, T>(storage, std::forward<A>(args)...); //inline functors are copied
+				else {
+					static_assert(std::is_copy_constructible_v<T>);
+					storage.ptr = heap<shared_block<T>, void>::create(std::forward<A>(args)...);
+					return shared_vtable<T>();
 				}
-				return false;
 			}
-		}
 
-
-		inline
-		auto nop_manage(storage_t *, storage_t *, mode) { return true; }
+			template<typename T, typename Alloc, typename... A>
+			static
+			auto init_allocated_shared_functor(storage_t & storage, const Alloc & alloc, A &&... args) -> const vtable * {
+				if constexpr(sbo<T, storage_t>) return init_functor<true, T>(storage, std::forward<A>(args)...); //inline functors are copied
+				else {
+					static_assert(std::is_copy_constructible_v<T>);
+					using byte_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<std::byte>;
+					storage.ptr = heap<shared_block<T>, byte_alloc>::create(byte_alloc{alloc}, std::forward<A>(args)...);
+					return shared_vtable<T, byte_alloc>();
+				}
+			}
+		};
 
 
-		template<bool Copyable, typename T, typename... A>
-		void construct(storage_t & storage, A &&... args) {
-			if constexpr(Copyable) static_assert(std::is_copy_constructible_v<T>);
-			//PRECONDITION: std::is_nothrow_destructible_v<T>
+		//! @brief vtable of compact wrappers, referenced by the header of their heap block
+		template<typename Dispatch>
+		struct compact_vtable final {
+			using dispatch_type = Dispatch;
 
-			if constexpr(sbo<T>) new(storage.sbo) T{std::forward<A>(args)...};
-			else storage.ptr = new T{std::forward<A>(args)...};
-		}
+			Dispatch dispatch;
+			void (*destroy)(compact_header *) noexcept; //nullptr if the functor is not owned by the wrapper
 
+			template<typename T, typename Alloc>
+			static
+			void destroy_block(compact_header * self) noexcept { heap<compact_block<T>, Alloc>::destroy(static_cast<compact_block<T> *>(self)); }
+		};
 
 		template<typename Traits>
-		struct vtable final {
-			bool (*manage)(storage_t *, storage_t *, mode);
-			typename Traits::dispatch_type dispatch;
+		struct compact_factory final {
+			using vtable = compact_vtable<typename Traits::erased_dispatch_type>;
 
-			void dtor(storage_t * self) const noexcept { manage(self, nullptr, mode::dtor); }
-			void destructive_move(storage_t * from, storage_t * to) const noexcept { manage(from, to, mode::destructive_move); }
-			void copy(const storage_t * from, storage_t * to) const { manage(const_cast<storage_t *>(from), to, mode::copy); }
-			auto noexcept_copyable() const noexcept -> bool { return manage(nullptr, nullptr, mode::copy_is_nothrow); }
+			//! @brief functors that can be shared between all wrappers, as they hold no state and are created and destroyed without side effects
+			template<typename T, typename... A>
+			static
+			constexpr
+			bool stateless{std::is_empty_v<T> && std::is_trivially_default_constructible_v<T> && std::is_trivially_constructible_v<T, A &&...> && std::is_trivially_destructible_v<T>};
 
+			template<typename T, typename Alloc = void>
 			static
-			void move_ctor(const vtable *& lhs_vptr, storage_t & lhs_storage, const vtable *& rhs_vptr, storage_t & rhs_storage) noexcept {
-				lhs_vptr = rhs_vptr;
-				rhs_vptr->destructive_move(&rhs_storage, &lhs_storage);
-				rhs_vptr = vtable::init_empty();
+			auto functor_vtable() noexcept -> const vtable * {
+				static constexpr vtable vtable{Traits::template compact_dispatch<T>, &vtable::template destroy_block<T, Alloc>};
+				return &vtable;
 			}
 
+			template<auto F, typename T>
 			static
-			void move_assign(const vtable *& lhs_vptr, storage_t & lhs_storage, const vtable *& rhs_vptr, storage_t & rhs_storage) noexcept {
-				if(&lhs_storage == &rhs_storage) return;
+			auto bound_vtable() noexcept -> const vtable * {
+				static constexpr vtable vtable{Traits::template compact_bound_dispatch<F, T>, &vtable::template destroy_block<T, void>};
+				return &vtable;
+			}
 
-				lhs_vptr->dtor(&lhs_storage);
-				lhs_vptr = rhs_vptr;
-				rhs_vptr->destructive_move(&rhs_storage, &lhs_storage);
-				rhs_vptr = vtable::init_empty();
+			static
+			auto function_pointer_vtable() noexcept -> const vtable * {
+				static constexpr vtable vtable{Traits::function_pointer_dispatch, nullptr};
+				return &vtable;
 			}
 
+			template<typename T>
 			static
-			void swap(const vtable *& lhs_vptr, storage_t & lhs_storage, const vtable *& rhs_vptr, storage_t & rhs_storage) noexcept {
-				if(&lhs_storage == &rhs_storage) return;
+			auto stateless_functor() noexcept -> compact_header * {
+				static constexpr vtable vtable{Traits::template compact_dispatch<T>, nullptr};
+				static constinit compact_block<T> block{&vtable};
+				return &block;
+			}
 
-				storage_t tmp;
-				lhs_vptr->destructive_move(&lhs_storage, &tmp);
-				rhs_vptr->destructive_move(&rhs_storage, &lhs_storage);
-				lhs_vptr->destructive_move(&tmp, &rhs_storage);
-				std::swap(lhs_vptr, rhs_vptr);
+			template<auto F>
+			static
+			auto nontype() noexcept -> compact_header * {
+				static constexpr vtable vtable{Traits::template nontype_dispatch<compact_header, F>, nullptr};
+				static constinit compact_block<nontype_t<F>> block{&vtable};
+				return &block;
 			}
 
-			template<bool Copyable, typename T, typename... A>
+			template<typename T, typename... A>
 			static
-			auto init_functor(storage_t & storage, A &&... args) -> const vtable * {
-				construct<Copyable, T>(storage, std::forward<A>(args)...);
-				static constexpr vtable vtable{&owning_manage<Copyable, T>, &Traits::template functor<T, sbo<T>>};
-				return &vtable;
+			auto functor(A &&... args) -> compact_header * {
+				if constexpr(stateless<T, A...>) return stateless_functor<T>();
+				else return heap<compact_block<T>, void>::create(functor_vtable<T>(), std::forward<A>(args)...);
 			}
 
+			template<auto F, typename T, typename... A>
 			static
-			auto init_empty() noexcept -> const vtable * {
-				static constexpr vtable vtable{&nop_manage, nullptr};
-				return &vtable;
+			auto bound(A &&... args) -> compact_header * { return heap<compact_block<T>, void>::create(bound_vtable<F, T>(), std::forward<A>(args)...); }
+
+			template<typename T, typename Alloc, typename... A>
+			static
+			auto allocated_functor(const Alloc & alloc, A &&... args) -> compact_header * {
+				if constexpr(stateless<T, A...>) return stateless_functor<T>();
+				else {
+					using byte_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<std::byte>;
+					return heap<compact_block<T>, byte_alloc>::create(byte_alloc{alloc}, functor_vtable<T, byte_alloc>(), std::forward<A>(args)...);
+				}
 			}
 		};
 
 
+		template<typename VTable, layout Layout>
+		class vtable_ref;
+
+		template<typename VTable>
+		class vtable_ref<VTable, layout::pointer> final {
+			const VTable * ptr;
+		public:
+			vtable_ref() noexcept =default;
+			vtable_ref(const VTable * ptr) noexcept : ptr{ptr} {}
+
+			auto get() const noexcept -> const VTable * { return ptr; }
+			auto operator->() const noexcept -> const VTable * { return ptr; }
+			auto dispatch() const noexcept -> const decltype(VTable::dispatch) & { return ptr->dispatch; }
+		};
+
+		template<typename VTable>
+		class vtable_ref<VTable, layout::fat_pointer> final {
+			decltype(VTable::dispatch) dispatch_; //hot: used by every invocation
+			const VTable * ptr;
+		public:
+			vtable_ref() noexcept =default;
+			vtable_ref(const VTable * ptr) noexcept : dispatch_{ptr->dispatch}, ptr{ptr} {}
+
+			auto get() const noexcept -> const VTable * { return ptr; }
+			auto operator->() const noexcept -> const VTable * { return ptr; }
+			auto dispatch() const noexcept -> const decltype(VTable::dispatch) & { return dispatch_; }
+		};
+
+		template<typename VTable>
+		class vtable_ref<VTable, layout::index> final {
+			std::uint32_t index;
+		public:
+			vtable_ref() noexcept =default;
+			vtable_ref(const VTable * ptr) noexcept : index{ptr->registered_index()} {}
+
+			auto get() const noexcept -> const VTable * { return static_cast<const VTable *>(vtable_registry::get(index)); }
+			auto operator->() const noexcept -> const VTable * { return get(); }
+			auto dispatch() const noexcept -> const decltype(VTable::dispatch) & { return get()->dispatch; }
+		};
+
+
 		template<bool Const, bool Noexcept, bool Move, typename Result, typename... Args>
 		class invoker {
 			template<typename T>
@@ -157,15 +1136,109 @@ namespace p2548 {
 				else return (t);
 			}
 
-			template<typename T, bool SBO>
+			template<typename T, bool SBO, typename Storage>
 			static
-			auto get(const_<storage_t> * ctx) noexcept -> move_<const_<T>> { return move(*reinterpret_cast<const_<T> *>(SBO ? ctx->sbo : ctx->ptr)); }
+			auto get(void * ctx) noexcept -> move_<const_<T>> {
+				const auto storage{static_cast<const_<Storage> *>(ctx)};
+				return move(*reinterpret_cast<const_<T> *>(SBO ? storage->sbo : storage->ptr));
+			}
 		public:
-			using dispatch_type = std::conditional_t<Noexcept, Result(*)(const_<storage_t> *, Args...) noexcept, Result(*)(const_<storage_t> *, Args...)>;
+			//! @note the context is a type-erased pointer to the storage, allowing function_ref to bind directly to the target of an owning wrapper
+			using dispatch_type = std::conditional_t<Noexcept, Result(*)(void *, internal_function_ref::param_t<Args>...) noexcept, Result(*)(void *, internal_function_ref::param_t<Args>...)>;
+
+			//! @brief dispatch type as stored in the vtable, the noexcept-specification is restored on invocation
+			using erased_dispatch_type = Result(*)(void *, internal_function_ref::param_t<Args>...);
+
+			//! @brief plain function pointer matching the signature, serves as canonical target for all convertible function pointers
+			using function_pointer = std::conditional_t<Noexcept, Result(*)(Args...) noexcept, Result(*)(Args...)>;
+
+			static
+			constexpr
+			bool is_const{Const};
+
+			//! @brief invoking a shared target through this signature may have to clone it within a noexcept call
+			static
+			constexpr
+			bool clones_noexcept{!Const && Noexcept};
+
+			//! @brief invokes a target of statically known type, bypassing the dispatch function
+			template<typename T>
+			static
+			auto direct(const_<T> & target, Args... args) noexcept(Noexcept) -> Result { return std::invoke_r<Result>(static_cast<move_<const_<T>>>(target), std::forward<Args>(args)...); }
+
+			template<typename Storage, typename T, bool SBO>
+			static
+			auto functor(void * ctx, internal_function_ref::param_t<Args>... args) noexcept(Noexcept) -> Result { return std::invoke_r<Result>(get<T, SBO, Storage>(ctx), std::forward<Args>(args)...); }
+
+			template<typename Storage, auto F>
+			static
+			auto nontype_functor(void *, internal_function_ref::param_t<Args>... args) noexcept(Noexcept) -> Result { return std::invoke_r<Result>(F, std::forward<Args>(args)...); }
+
+			template<typename Storage, auto F, typename T, bool SBO>
+			static
+			auto bound_functor(void * ctx, internal_function_ref::param_t<Args>... args) noexcept(Noexcept) -> Result { return std::invoke_r<Result>(F, get<T, SBO, Storage>(ctx), std::forward<Args>(args)...); }
+
+			template<typename Storage, typename T, typename Alloc>
+			static
+			auto shared_functor(void * ctx, internal_function_ref::param_t<Args>... args) noexcept(Noexcept) -> Result {
+				const auto storage{static_cast<const_<Storage> *>(ctx)};
+				const_<shared_block<T>> * block;
+				if constexpr(Const) block = static_cast<const shared_block<T> *>(storage->ptr);
+				else block = shared_block<T>::template unshare<Alloc>(storage->ptr); //copy-on-write
+				return std::invoke_r<Result>(static_cast<move_<const_<T>>>(block->value), std::forward<Args>(args)...);
+			}
+
+			template<typename T>
+			static
+			auto compact_functor(void * ctx, internal_function_ref::param_t<Args>... args) noexcept(Noexcept) -> Result {
+				const auto block{static_cast<const_<compact_block<T>> *>(static_cast<compact_header *>(ctx))};
+				return std::invoke_r<Result>(static_cast<move_<const_<T>>>(block->value), std::forward<Args>(args)...);
+			}
+
+			template<auto F, typename T>
+			static
+			auto compact_bound_functor(void * ctx, internal_function_ref::param_t<Args>... args) noexcept(Noexcept) -> Result {
+				const auto block{static_cast<const_<compact_block<T>> *>(static_cast<compact_header *>(ctx))};
+				return std::invoke_r<Result>(F, static_cast<move_<const_<T>>>(block->value), std::forward<Args>(args)...);
+			}
 
-			template<typename T, bool SBO>
 			static
-			auto functor(const_<storage_t> * ctx, Args... args) noexcept(Noexcept) -> Result { return std::invoke_r<Result>(get<T, SBO>(ctx), std::forward<Args>(args)...); }
+			auto function_pointer_functor(void * ctx, internal_function_ref::param_t<Args>... args) noexcept(Noexcept) -> Result { return std::invoke_r<Result>(reinterpret_cast<function_pointer>(reinterpret_cast<std::uintptr_t>(ctx)), std::forward<Args>(args)...); }
+
+			template<typename Storage, typename T, bool SBO>
+			static
+			constexpr
+			dispatch_type functor_dispatch{&functor<Storage, T, SBO>};
+
+			template<typename Storage, auto F>
+			static
+			constexpr
+			dispatch_type nontype_dispatch{&nontype_functor<Storage, F>};
+
+			template<typename Storage, auto F, typename T, bool SBO>
+			static
+			constexpr
+			dispatch_type bound_dispatch{&bound_functor<Storage, F, T, SBO>};
+
+			template<typename Storage, typename T, typename Alloc>
+			static
+			constexpr
+			dispatch_type shared_dispatch{&shared_functor<Storage, T, Alloc>};
+
+			template<typename T>
+			static
+			constexpr
+			dispatch_type compact_dispatch{&compact_functor<T>};
+
+			template<auto F, typename T>
+			static
+			constexpr
+			dispatch_type compact_bound_dispatch{&compact_bound_functor<F, T>};
+
+			//! @note the context is the function pointer itself
+			static
+			constexpr
+			dispatch_type function_pointer_dispatch{&function_pointer_functor};
 		};
 
 
@@ -301,106 +1374,270 @@ namespace p2548 {
 		};
 
 
-		template<typename Impl, typename Signature>
+		//! @brief combined traits of a wrapper with multiple signatures, dispatching through one entry per signature
+		template<typename... Traits>
+		struct overloads final {
+			using dispatch_type = std::tuple<typename Traits::dispatch_type...>;
+			using erased_dispatch_type = std::tuple<typename Traits::erased_dispatch_type...>;
+
+			static
+			constexpr
+			bool clones_noexcept{(Traits::clones_noexcept || ...)};
+
+			template<typename... T>
+			static
+			constexpr
+			bool is_invocable_using{(Traits::template is_invocable_using<T...> && ...)};
+
+			template<typename Storage, typename T, bool SBO>
+			static
+			constexpr
+			dispatch_type functor_dispatch{Traits::template functor_dispatch<Storage, T, SBO>...};
+
+			template<typename Storage, auto F>
+			static
+			constexpr
+			dispatch_type nontype_dispatch{Traits::template nontype_dispatch<Storage, F>...};
+
+			template<typename Storage, auto F, typename T, bool SBO>
+			static
+			constexpr
+			dispatch_type bound_dispatch{Traits::template bound_dispatch<Storage, F, T, SBO>...};
+
+			template<typename Storage, typename T, typename Alloc>
+			static
+			constexpr
+			dispatch_type shared_dispatch{Traits::template shared_dispatch<Storage, T, Alloc>...};
+
+			template<typename T>
+			static
+			constexpr
+			dispatch_type compact_dispatch{Traits::template compact_dispatch<T>...};
+
+			template<auto F, typename T>
+			static
+			constexpr
+			dispatch_type compact_bound_dispatch{Traits::template compact_bound_dispatch<F, T>...};
+		};
+
+
+		template<typename Traits, typename VT>
+		inline
+		constexpr
+		bool is_callable_from{Traits::template is_invocable_using<typename Traits::template quals<VT>> && Traits::template is_invocable_using<typename Traits::template inv_quals<VT>>};
+
+		template<typename... Traits, typename VT>
+		inline
+		constexpr
+		bool is_callable_from<overloads<Traits...>, VT>{(is_callable_from<Traits, VT> && ...)};
+
+
+		template<typename Traits, auto F, typename VT>
+		inline
+		constexpr
+		bool is_bindable{Traits::template is_invocable_using<decltype(F), typename Traits::template inv_quals<VT>>};
+
+		template<typename... Traits, auto F, typename VT>
+		inline
+		constexpr
+		bool is_bindable<overloads<Traits...>, F, VT>{(is_bindable<Traits, F, VT> && ...)};
+
+
+		//! @brief checks if a shared target can be cloned on invocation without calling std::terminate due to a throwing copy constructor
+		//! @note the allocation of the clone may still fail within a noexcept call
+		template<typename Traits, typename VT, typename Storage, typename Options>
+		constexpr
+		auto shareable() noexcept -> bool {
+			if constexpr(!Options::shared || !Traits::clones_noexcept) return true;
+			else return sbo<VT, Storage> || std::is_nothrow_copy_constructible_v<VT>;
+		}
+
+		template<typename Traits, typename VT, typename Storage, typename Options>
+		inline
+		constexpr
+		bool is_shareable{shareable<Traits, VT, Storage, Options>()};
+
+
+		//! @brief selects the dispatch entry of a signature and restores its noexcept-specification
+		//! @note well-defined as the vtables of noexcept signatures only ever store noexcept entries
+		template<typename Traits, std::size_t Index, typename Dispatch>
+		auto select_dispatch(const Dispatch & dispatch) noexcept {
+			if constexpr(std::is_pointer_v<Dispatch>) return reinterpret_cast<typename Traits::dispatch_type>(dispatch);
+			else return reinterpret_cast<std::tuple_element_t<Index, typename Traits::dispatch_type>>(std::get<Index>(dispatch));
+		}
+
+		template<typename Dispatch>
+		constexpr
+		auto has_target(const Dispatch & dispatch) noexcept -> bool {
+			if constexpr(std::is_pointer_v<Dispatch>) return dispatch != nullptr;
+			else return std::get<0>(dispatch) != nullptr; //all entries are set for non-empty wrappers
+		}
+
+
+		template<typename... Ts>
+		struct type_list final {
+			static
+			constexpr
+			std::size_t size{sizeof...(Ts)};
+		};
+
+		//! @brief separates the function signatures from the policies passed to a wrapper
+		template<typename Signatures, typename Policies, typename... Ts>
+		struct split_arguments final {
+			using signatures = Signatures;
+			using policies = Policies;
+		};
+
+		template<typename... Signatures, typename... Policies, typename T, typename... Ts>
+		struct split_arguments<type_list<Signatures...>, type_list<Policies...>, T, Ts...> final {
+			using next = std::conditional_t<
+				std::is_function_v<T>,
+				split_arguments<type_list<Signatures..., T>, type_list<Policies...>, Ts...>,
+				split_arguments<type_list<Signatures...>, type_list<Policies..., T>, Ts...>
+			>;
+			using signatures = typename next::signatures;
+			using policies = typename next::policies;
+		};
+
+		template<typename Signatures>
+		struct traits_for;
+
+		template<typename Signature>
+		struct traits_for<type_list<Signature>> final { using type = traits<Signature>; };
+
+		template<typename... Signatures>
+		requires(sizeof...(Signatures) > 1)
+		struct traits_for<type_list<Signatures...>> final { using type = overloads<traits<Signatures>...>; };
+
+		template<typename Policies>
+		struct options_for;
+
+		template<typename... Policies>
+		struct options_for<type_list<Policies...>> final { using type = options_t<Policies...>; };
+
+		//! @brief configuration of a wrapper specialization: traits of its signature(s) and options of its policies
+		template<typename... Ts>
+		struct wrapper_config final {
+			using arguments = split_arguments<type_list<>, type_list<>, Ts...>;
+			using signatures = typename arguments::signatures;
+			using traits = typename traits_for<signatures>::type;
+			using options = typename options_for<typename arguments::policies>::type;
+			using storage = storage_t<options::capacity + (options::vtable_layout == layout::index ? sizeof(void *) - sizeof(std::uint32_t) : 0), options::alignment, options::pinned, options::vtable_layout == layout::index>; //a compressed vtable leaves the bytes saved to the buffer, regardless of the order of policies
+		};
+
+
+		template<typename Impl, typename Signature, std::size_t Index = 0>
 		struct function_call;
 
-		template<typename Impl, typename Result, typename... Args>
-		struct function_call<Impl, Result(Args...)> {
+		template<typename Impl, typename Result, typename... Args, std::size_t Index>
+		struct function_call<Impl, Result(Args...), Index> {
 			auto operator()(Args... args) -> Result {
 				auto & self{*static_cast<Impl *>(this)};
-				return self.vptr->dispatch(&self.storage, std::forward<Args>(args)...);
+				return select_dispatch<typename Impl::traits, Index>(self.dispatch())(self.context(), std::forward<Args>(args)...);
 			}
 		};
 
-		template<typename Impl, typename Result, typename... Args>
-		struct function_call<Impl, Result(Args...) const> {
+		template<typename Impl, typename Result, typename... Args, std::size_t Index>
+		struct function_call<Impl, Result(Args...) const, Index> {
 			auto operator()(Args... args) const -> Result {
 				auto & self{*static_cast<const Impl *>(this)};
-				return self.vptr->dispatch(&self.storage, std::forward<Args>(args)...);
+				return select_dispatch<typename Impl::traits, Index>(self.dispatch())(self.context(), std::forward<Args>(args)...);
 			}
 		};
 
-		template<typename Impl, typename Result, typename... Args>
-		struct function_call<Impl, Result(Args...) noexcept> {
+		template<typename Impl, typename Result, typename... Args, std::size_t Index>
+		struct function_call<Impl, Result(Args...) noexcept, Index> {
 			auto operator()(Args... args) noexcept -> Result {
 				auto & self{*static_cast<Impl *>(this)};
-				return self.vptr->dispatch(&self.storage, std::forward<Args>(args)...);
+				return select_dispatch<typename Impl::traits, Index>(self.dispatch())(self.context(), std::forward<Args>(args)...);
 			}
 		};
 
-		template<typename Impl, typename Result, typename... Args>
-		struct function_call<Impl, Result(Args...) const noexcept> {
+		template<typename Impl, typename Result, typename... Args, std::size_t Index>
+		struct function_call<Impl, Result(Args...) const noexcept, Index> {
 			auto operator()(Args... args) const noexcept -> Result {
 				auto & self{*static_cast<const Impl *>(this)};
-				return self.vptr->dispatch(&self.storage, std::forward<Args>(args)...);
+				return select_dispatch<typename Impl::traits, Index>(self.dispatch())(self.context(), std::forward<Args>(args)...);
 			}
 		};
 
-		template<typename Impl, typename Result, typename... Args>
-		struct function_call<Impl, Result(Args...) &> {
+		template<typename Impl, typename Result, typename... Args, std::size_t Index>
+		struct function_call<Impl, Result(Args...) &, Index> {
 			auto operator()(Args... args) & -> Result {
 				auto & self{*static_cast<Impl *>(this)};
-				return self.vptr->dispatch(&self.storage, std::forward<Args>(args)...);
+				return select_dispatch<typename Impl::traits, Index>(self.dispatch())(self.context(), std::forward<Args>(args)...);
 			}
 		};
 
-		template<typename Impl, typename Result, typename... Args>
-		struct function_call<Impl, Result(Args...) const &> {
+		template<typename Impl, typename Result, typename... Args, std::size_t Index>
+		struct function_call<Impl, Result(Args...) const &, Index> {
 			auto operator()(Args... args) const & -> Result {
 				auto & self{*static_cast<const Impl *>(this)};
-				return self.vptr->dispatch(&self.storage, std::forward<Args>(args)...);
+				return select_dispatch<typename Impl::traits, Index>(self.dispatch())(self.context(), std::forward<Args>(args)...);
 			}
 		};
 
-		template<typename Impl, typename Result, typename... Args>
-		struct function_call<Impl, Result(Args...) & noexcept> {
+		template<typename Impl, typename Result, typename... Args, std::size_t Index>
+		struct function_call<Impl, Result(Args...) & noexcept, Index> {
 			auto operator()(Args... args) & noexcept -> Result {
 				auto & self{*static_cast<Impl *>(this)};
-				return self.vptr->dispatch(&self.storage, std::forward<Args>(args)...);
+				return select_dispatch<typename Impl::traits, Index>(self.dispatch())(self.context(), std::forward<Args>(args)...);
 			}
 		};
 
-		template<typename Impl, typename Result, typename... Args>
-		struct function_call<Impl, Result(Args...) const & noexcept> {
+		template<typename Impl, typename Result, typename... Args, std::size_t Index>
+		struct function_call<Impl, Result(Args...) const & noexcept, Index> {
 			auto operator()(Args... args) const & noexcept -> Result {
 				auto & self{*static_cast<const Impl *>(this)};
-				return self.vptr->dispatch(&self.storage, std::forward<Args>(args)...);
+				return select_dispatch<typename Impl::traits, Index>(self.dispatch())(self.context(), std::forward<Args>(args)...);
 			}
 		};
 
-		template<typename Impl, typename Result, typename... Args>
-		struct function_call<Impl, Result(Args...) &&> {
+		template<typename Impl, typename Result, typename... Args, std::size_t Index>
+		struct function_call<Impl, Result(Args...) &&, Index> {
 			auto operator()(Args... args) && -> Result {
 				auto & self{*static_cast<Impl *>(this)};
-				return self.vptr->dispatch(&self.storage, std::forward<Args>(args)...);
+				return select_dispatch<typename Impl::traits, Index>(self.dispatch())(self.context(), std::forward<Args>(args)...);
 			}
 		};
 
-		template<typename Impl, typename Result, typename... Args>
-		struct function_call<Impl, Result(Args...) const &&> {
+		template<typename Impl, typename Result, typename... Args, std::size_t Index>
+		struct function_call<Impl, Result(Args...) const &&, Index> {
 			auto operator()(Args... args) const && -> Result {
 				auto & self{*static_cast<const Impl *>(this)};
-				return self.vptr->dispatch(&self.storage, std::forward<Args>(args)...);
+				return select_dispatch<typename Impl::traits, Index>(self.dispatch())(self.context(), std::forward<Args>(args)...);
 			}
 		};
 
-		template<typename Impl, typename Result, typename... Args>
-		struct function_call<Impl, Result(Args...) && noexcept> {
+		template<typename Impl, typename Result, typename... Args, std::size_t Index>
+		struct function_call<Impl, Result(Args...) && noexcept, Index> {
 			auto operator()(Args... args) && noexcept -> Result {
 				auto & self{*static_cast<Impl *>(this)};
-				return self.vptr->dispatch(&self.storage, std::forward<Args>(args)...);
+				return select_dispatch<typename Impl::traits, Index>(self.dispatch())(self.context(), std::forward<Args>(args)...);
 			}
 		};
 
-		template<typename Impl, typename Result, typename... Args>
-		struct function_call<Impl, Result(Args...) const && noexcept> {
+		template<typename Impl, typename Result, typename... Args, std::size_t Index>
+		struct function_call<Impl, Result(Args...) const && noexcept, Index> {
 			auto operator()(Args... args) const && noexcept -> Result {
 				auto & self{*static_cast<const Impl *>(this)};
-				return self.vptr->dispatch(&self.storage, std::forward<Args>(args)...);
+				return select_dispatch<typename Impl::traits, Index>(self.dispatch())(self.context(), std::forward<Args>(args)...);
 			}
 		};
 
 
+		template<typename Impl, typename Signatures, typename Indices>
+		struct function_call_set;
+
+		template<typename Impl, typename... Signatures, std::size_t... Indices>
+		struct function_call_set<Impl, type_list<Signatures...>, std::index_sequence<Indices...>> : function_call<Impl, Signatures, Indices>... {
+			using function_call<Impl, Signatures, Indices>::operator()...;
+		};
+
+		template<typename Impl, typename Signatures>
+		using function_calls = function_call_set<Impl, Signatures, std::make_index_sequence<Signatures::size>>;
+
+
 		template<typename...>
 		struct is_move_only_function_specialization : std::false_type {};
 
@@ -425,6 +1662,30 @@ namespace p2548 {
 		bool is_copyable_function_specialization_v{is_copyable_function_specialization<Ts...>::value};
 
 
+		template<typename...>
+		struct is_compact_move_only_function_specialization : std::false_type {};
+
+		template<typename... Ts>
+		struct is_compact_move_only_function_specialization<compact_move_only_function<Ts...>> : std::true_type {};
+
+		template<typename... Ts>
+		inline
+		constexpr
+		bool is_compact_move_only_function_specialization_v{is_compact_move_only_function_specialization<Ts...>::value};
+
+
+		template<typename>
+		struct is_std_function_specialization : std::false_type {};
+
+		template<typename Signature>
+		struct is_std_function_specialization<std::function<Signature>> : std::true_type {};
+
+		template<typename T>
+		inline
+		constexpr
+		bool is_std_function_specialization_v{is_std_function_specialization<T>::value};
+
+
 		template<typename>
 		struct is_in_place_type_t_specialization : std::false_type {};
 
@@ -435,48 +1696,167 @@ namespace p2548 {
 		inline
 		constexpr
 		bool is_in_place_type_t_specialization_v{is_in_place_type_t_specialization<T>::value};
+
+
+		template<typename Wrapper>
+		struct cached_call;
 	}
 
 
-	template<typename Signature>
-	class move_only_function<Signature> final : internal_function::function_call<move_only_function<Signature>, Signature> {
-		using traits = internal_function::traits<Signature>;
-		using vtable = internal_function::vtable<traits>;
-		friend internal_function::function_call<move_only_function, Signature>;
+	//! @brief allocator drawing from the thread-cached size-class pool that is used by the owning function wrappers if P2548_POOLED_ALLOCATION is defined
+	//! @tparam T value type of the allocator
+	template<typename T>
+	struct pool_allocator final {
+		using value_type = T;
+		using is_always_equal = std::true_type;
+
+		constexpr
+		pool_allocator() noexcept =default;
+
+		template<typename U>
+		constexpr
+		pool_allocator(const pool_allocator<U> &) noexcept {}
+
+		auto allocate(std::size_t n) -> T * {
+			if(n <= internal_function::pool::max_size / sizeof(T) && internal_function::pool::supports(n * sizeof(T), alignof(T))) return static_cast<T *>(internal_function::pool::allocate(n * sizeof(T)));
+			return std::allocator<T>{}.allocate(n);
+		}
+
+		void deallocate(T * ptr, std::size_t n) noexcept {
+			if(n <= internal_function::pool::max_size / sizeof(T) && internal_function::pool::supports(n * sizeof(T), alignof(T))) internal_function::pool::deallocate(ptr, n * sizeof(T));
+			else std::allocator<T>{}.deallocate(ptr, n);
+		}
+
+		template<typename U>
+		friend
+		constexpr
+		auto operator==(const pool_allocator &, const pool_allocator<U> &) noexcept -> bool { return true; }
+	};
+
+
+	//! @brief move_only_function that never allocates
+	//! @tparam Capacity number of bytes available to store functors, larger functors are rejected
+	template<typename Signature, std::size_t Capacity = 3 * sizeof(void *)>
+	using inplace_move_only_function = move_only_function<Signature, inline_capacity<Capacity>, inplace_only>;
+
+	//! @brief copyable_function that never allocates
+	//! @tparam Capacity number of bytes available to store functors, larger functors are rejected
+	template<typename Signature, std::size_t Capacity = 3 * sizeof(void *)>
+	using inplace_copyable_function = copyable_function<Signature, inline_capacity<Capacity>, inplace_only>;
+
+
+	//! @brief trait to detect if an owning wrapper can be constructed from F and stores it in its inline buffer, i.e. without allocating
+	//! @note holds for wrappers only holding inline targets whose target (and vtable) is adopted
+	template<typename Wrapper, typename F>
+	struct stores_inline : std::false_type {};
+
+	template<typename... Ts, typename F>
+	struct stores_inline<move_only_function<Ts...>, F> : std::bool_constant<std::is_constructible_v<move_only_function<Ts...>, F> && (internal_function::sbo<std::decay_t<F>, typename internal_function::wrapper_config<Ts...>::storage> || move_only_function<Ts...>::template adopts_inline<std::remove_cvref_t<F>>())> {};
+
+	template<typename... Ts, typename F>
+	struct stores_inline<copyable_function<Ts...>, F> : std::bool_constant<std::is_constructible_v<copyable_function<Ts...>, F> && (internal_function::sbo<std::decay_t<F>, typename internal_function::wrapper_config<Ts...>::storage> || copyable_function<Ts...>::template adopts_inline<std::remove_cvref_t<F>>())> {};
+
+	template<typename Wrapper, typename F>
+	inline
+	constexpr
+	bool stores_inline_v{stores_inline<Wrapper, F>::value};
+
+
+	template<typename Signature, typename... Ts>
+	class move_only_function<Signature, Ts...> final : internal_function::function_calls<move_only_function<Signature, Ts...>, typename internal_function::wrapper_config<Signature, Ts...>::signatures> {
+		using config = internal_function::wrapper_config<Signature, Ts...>;
+		using traits = typename config::traits;
+		using options = typename config::options;
+		using vtable_factory = internal_function::vtable_factory<traits, typename config::storage>;
+		using vtable = typename vtable_factory::vtable;
+		template<typename, typename, std::size_t>
+		friend struct internal_function::function_call;
+		friend internal_function_ref::target_access<move_only_function>;
+		friend internal_function::cached_call<move_only_function>;
+		template<typename...>
+		friend class move_only_function;
+		template<typename, typename>
+		friend struct stores_inline;
+		static_assert(!options::shared, "shared_storage requires copyable_function");
+		static_assert(!(options::pinned && options::trivial), "pinned cannot be combined with trivially_relocatable");
+
+		template<typename... T>
+		static
+		constexpr
+		bool is_invocable_using{traits::template is_invocable_using<T...>};
+
+		template<typename VT>
+		static
+		constexpr
+		bool is_callable_from{internal_function::is_callable_from<traits, VT> && internal_function::is_storable<VT, typename vtable::storage_t, options>};
+
+		//! @brief checks if the target of wrapper F can be adopted including its vtable, which holds for all qualifier-relaxing conversions
+		template<typename F>
+		static
+		constexpr
+		auto shares_vtable() noexcept -> bool {
+			if constexpr(internal_function::is_move_only_function_specialization_v<F> || internal_function::is_copyable_function_specialization_v<F>) return std::is_same_v<vtable, typename F::vtable> && (!options::trivial || F::options::trivial) && !options::pinned;
+			else return false;
+		}
+
+		//! @brief checks if wrapper F only holds inline targets and they are adopted, so converting from it never allocates
+		template<typename F>
+		static
+		constexpr
+		auto adopts_inline() noexcept -> bool {
+			if constexpr(shares_vtable<F>()) return F::options::inplace || F::options::trivial;
+			else return false;
+		}
 
-		template<typename... T>
+		//! @brief checks if converting from wrapper F adopts its target, which must not introduce heap-allocated targets into inplace_only wrappers
+		template<typename F>
 		static
 		constexpr
-		bool is_invocable_using{traits::template is_invocable_using<T...>};
+		auto adoptable() noexcept -> bool {
+			if constexpr(shares_vtable<F>()) return !options::inplace || adopts_inline<F>();
+			else return false;
+		}
 
-		template<typename VT>
+		//! @brief checks if the target adopted from wrapper F may be a shared functor that throws when cloned by a noexcept call of this wrapper
+		template<typename F>
 		static
 		constexpr
-		bool is_callable_from{is_invocable_using<typename traits::template quals<VT>> && is_invocable_using<typename traits::template inv_quals<VT>>};
+		auto checks_unshare() noexcept -> bool {
+			if constexpr(internal_function::is_copyable_function_specialization_v<F>) return traits::clones_noexcept && !F::traits::clones_noexcept && F::options::shared;
+			else return false;
+		}
+
+		alignas(vtable::storage_t::alignment) typename vtable::storage_t storage; //first, so that a compressed vtable index occupies the bytes following it
+		internal_function::vtable_ref<vtable, options::vtable_layout> vptr;
 
-		const vtable * vptr;
-		internal_function::storage_t storage;
+		auto dispatch() const noexcept -> const typename vtable::dispatch_type & { return vptr.dispatch(); }
+		auto context() const noexcept -> void * { return const_cast<typename vtable::storage_t *>(&storage); }
 	public:
 		move_only_function() noexcept : vptr{vtable::init_empty()} {}
 		move_only_function(std::nullptr_t) noexcept : move_only_function{} {}
 
-		template<typename F, typename = std::enable_if_t<(!std::is_same_v<move_only_function, std::remove_cvref_t<F>> && !internal_function::is_in_place_type_t_specialization_v<std::remove_cvref_t<F>> && is_callable_from<std::decay_t<F>>)>> //TODO: [C++20] replace with concepts/requires-clause
+		template<typename F, typename = std::enable_if_t<(!std::is_same_v<move_only_function, std::remove_cvref_t<F>> && !internal_function::is_in_place_type_t_specialization_v<std::remove_cvref_t<F>> && (is_callable_from<std::decay_t<F>> || adoptable<std::remove_cvref_t<F>>()))>> //TODO: [C++20] replace with concepts/requires-clause
 		move_only_function(F && func) {
 			using VT = std::decay_t<F>;
 			static_assert(std::is_constructible_v<VT, F>);
-			if constexpr(std::is_function_v<std::remove_pointer_t<F>> || std::is_member_pointer_v<F> || internal_function::is_move_only_function_specialization_v<std::remove_cvref_t<F>>) {
-				if(!func) vptr = vtable::init_empty();
-				else vptr = vtable::template init_functor<false, VT>(storage, std::forward<F>(func));
-			} else if constexpr(typedef copyable_function<Signature> copyable; /*TODO: [C++23] use using instead of typedef here...*/ std::is_same_v<std::remove_cvref_t<F>, copyable>) { //QoI: prevent double-wrapping
-				if constexpr(std::is_same_v<F, copyable>) {
-					vptr = func.vptr;
+			if constexpr(shares_vtable<std::remove_cvref_t<F>>()) { //QoI: prevent double-wrapping
+				if constexpr(checks_unshare<std::remove_cvref_t<F>>())
+					if(func.vptr->has(internal_function::capability::throwing_unshare)) { //invoked through a const signature, the wrapped source never clones its target
+						vptr = vtable_factory::template init_functor<false, VT>(storage, std::forward<F>(func));
+						return;
+					}
+				if constexpr(std::is_same_v<F, std::remove_cvref_t<F>>) {
+					vptr = func.vptr.get();
 					func.vptr->destructive_move(&func.storage, &storage);
 					func.vptr = vtable::init_empty();
 				} else {
-					vptr = func.vptr;
+					vptr = func.vptr.get();
 					func.vptr->copy(&func.storage, &storage);
 				}
-			} else vptr = vtable::template init_functor<false, VT>(storage, std::forward<F>(func));
+			} else if constexpr(std::is_function_v<std::remove_pointer_t<F>> || std::is_member_pointer_v<F> || internal_function::is_move_only_function_specialization_v<std::remove_cvref_t<F>> || internal_function::is_copyable_function_specialization_v<std::remove_cvref_t<F>> || internal_function::is_std_function_specialization_v<std::remove_cvref_t<F>>) {
+				if(!func) vptr = vtable::init_empty();
+				else vptr = vtable_factory::template init_functor<false, VT>(storage, std::forward<F>(func));
+			} else vptr = vtable_factory::template init_functor<false, VT>(storage, std::forward<F>(func));
 		}
 
 		template<typename T, typename... A>
@@ -484,7 +1864,7 @@ namespace p2548 {
 		explicit
 		move_only_function(std::in_place_type_t<T>, A &&... args) {
 			static_assert(std::is_same_v<T, std::decay_t<T>>);
-			vptr = vtable::template init_functor<false, T>(storage, std::forward<A>(args)...);
+			vptr = vtable_factory::template init_functor<false, T>(storage, std::forward<A>(args)...);
 		}
 
 		template<typename T, typename U, typename... A>
@@ -492,52 +1872,138 @@ namespace p2548 {
 		explicit
 		move_only_function(std::in_place_type_t<T>, std::initializer_list<U> ilist, A &&... args) {
 			static_assert(std::is_same_v<T, std::decay_t<T>>);
-			vptr = vtable::template init_functor<false, T>(storage, ilist, std::forward<A>(args)...);
+			vptr = vtable_factory::template init_functor<false, T>(storage, ilist, std::forward<A>(args)...);
+		}
+
+		template<auto F>
+		requires(is_invocable_using<decltype(F)>)
+		move_only_function(nontype_t<F>) noexcept {
+			if constexpr(std::is_pointer_v<decltype(F)> || std::is_member_pointer_v<decltype(F)>) static_assert(F != nullptr);
+			vptr = vtable_factory::template init_nontype<F>(storage);
+		}
+
+		template<auto F, typename T>
+		requires(std::is_constructible_v<std::decay_t<T>, T> && internal_function::is_bindable<traits, F, std::decay_t<T>> && internal_function::is_storable<std::decay_t<T>, typename vtable::storage_t, options>)
+		move_only_function(nontype_t<F>, T && obj) {
+			vptr = vtable_factory::template init_bound<false, F, std::decay_t<T>>(storage, std::forward<T>(obj));
+		}
+
+		template<typename Alloc, typename F>
+		requires(!std::is_same_v<move_only_function, std::remove_cvref_t<F>> && !internal_function::is_in_place_type_t_specialization_v<std::remove_cvref_t<F>> && is_callable_from<std::decay_t<F>>)
+		move_only_function(std::allocator_arg_t, const Alloc & alloc, F && func) {
+			using VT = std::decay_t<F>;
+			static_assert(std::is_constructible_v<VT, F>);
+			if constexpr(std::is_function_v<std::remove_pointer_t<F>> || std::is_member_pointer_v<F> || internal_function::is_move_only_function_specialization_v<std::remove_cvref_t<F>> || internal_function::is_copyable_function_specialization_v<std::remove_cvref_t<F>> || internal_function::is_std_function_specialization_v<std::remove_cvref_t<F>>)
+				if(!func) {
+					vptr = vtable::init_empty();
+					return;
+				}
+			vptr = vtable_factory::template init_allocated_functor<false, VT>(storage, alloc, std::forward<F>(func));
+		}
+
+		template<typename Alloc, typename T, typename... A>
+		requires(std::is_constructible_v<std::decay_t<T>, A &&...> && is_callable_from<std::decay_t<T>>)
+		explicit
+		move_only_function(std::allocator_arg_t, const Alloc & alloc, std::in_place_type_t<T>, A &&... args) {
+			static_assert(std::is_same_v<T, std::decay_t<T>>);
+			vptr = vtable_factory::template init_allocated_functor<false, T>(storage, alloc, std::forward<A>(args)...);
+		}
+
+		template<typename Alloc, typename T, typename U, typename... A>
+		requires(std::is_constructible_v<std::decay_t<T>, std::initializer_list<U> &, A &&...> && is_callable_from<std::decay_t<T>>)
+		explicit
+		move_only_function(std::allocator_arg_t, const Alloc & alloc, std::in_place_type_t<T>, std::initializer_list<U> ilist, A &&... args) {
+			static_assert(std::is_same_v<T, std::decay_t<T>>);
+			vptr = vtable_factory::template init_allocated_functor<false, T>(storage, alloc, ilist, std::forward<A>(args)...);
 		}
 
 		move_only_function(const move_only_function &) =delete;
 
-		move_only_function(move_only_function && other) noexcept { vtable::move_ctor(vptr, storage, other.vptr, other.storage); }
+		move_only_function(move_only_function &&) noexcept requires(options::trivial) =default;
+		move_only_function(move_only_function && other) noexcept requires(!options::trivial && !options::pinned) { vtable::move_ctor(vptr, storage, other.vptr, other.storage); }
+		move_only_function(move_only_function &&) requires(options::pinned) =delete;
 
 		auto operator=(const move_only_function &) -> move_only_function & =delete;
 
-		auto operator=(move_only_function && other) noexcept -> move_only_function & {
+		auto operator=(move_only_function &&) noexcept -> move_only_function & requires(options::trivial) =default;
+		auto operator=(move_only_function &&) -> move_only_function & requires(options::pinned) =delete;
+		auto operator=(move_only_function && other) noexcept -> move_only_function & requires(!options::trivial && !options::pinned) {
 			vtable::move_assign(vptr, storage, other.vptr, other.storage);
 			return *this;
 		}
 		auto operator=(std::nullptr_t) noexcept -> move_only_function & {
-			if(*this) move_only_function{}.swap(*this);
+			vptr->dtor(&storage);
+			vptr = vtable::init_empty();
 			return *this;
 		}
 
 		template<typename F>
-		auto operator=(F && func) -> move_only_function & {
-			move_only_function{std::forward<F>(func)}.swap(*this);
-			return *this;
+		requires(!options::pinned)
+		auto operator=(F && func) -> move_only_function & { return *this = move_only_function{std::forward<F>(func)}; } //strong exception guarantee, relocates the new target once
+
+		//! @brief destroys the current target and constructs a T in its place, reusing its heap block if it is of the same size class
+		//! @note the wrapper is empty if the construction throws, args must not refer to the current target
+		template<typename T, typename... A>
+		requires(std::is_constructible_v<std::decay_t<T>, A &&...> && is_callable_from<std::decay_t<T>>)
+		void emplace(A &&... args) {
+			static_assert(std::is_same_v<T, std::decay_t<T>>);
+			const auto & old{*vptr.get()};
+			vptr = vtable::init_empty();
+			vptr = vtable_factory::template reinit_functor<false, T>(old, storage, std::forward<A>(args)...);
 		}
 
-		~move_only_function() noexcept { vptr->dtor(&storage); }
+		~move_only_function() noexcept requires(options::trivial) =default;
+		~move_only_function() noexcept requires(!options::trivial) { vptr->dtor(&storage); }
 
-		using internal_function::function_call<move_only_function, Signature>::operator();
+		using internal_function::function_calls<move_only_function, typename config::signatures>::operator();
 
 		explicit
-		operator bool() const noexcept { return vptr->dispatch; }
+		operator bool() const noexcept { return internal_function::has_target(vptr.dispatch()); }
+
+#if defined(__cpp_rtti) || defined(__GXX_RTTI) || defined(_CPPRTTI)
+		//! @returns type of the stored target or typeid(void) if empty
+		//! @note function pointers are stored as the plain function pointer type of the signature if convertible
+		auto target_type() const noexcept -> const std::type_info & { return vptr->type->info; }
+#endif
+
+		//! @returns pointer to the stored target if it is of type T, nullptr otherwise
+		//! @note compares the type tag of the vtable, so no RTTI is required
+		template<typename T>
+		requires(std::is_object_v<T>)
+		auto target() const noexcept -> const T * { return vptr->template target<T>(&storage); }
+		//! @throws if a shared target must be copied to grant mutable access
+		template<typename T>
+		requires(std::is_object_v<T>)
+		auto target() -> T * { return vptr->template target<T>(&storage); }
 
-		void swap(move_only_function & other) noexcept { vtable::swap(vptr, storage, other.vptr, other.storage); }
+		void swap(move_only_function & other) noexcept requires(!options::pinned) { vtable::swap(vptr, storage, other.vptr, other.storage); }
 		friend
-		void swap(move_only_function & lhs, move_only_function & rhs) noexcept { lhs.swap(rhs); }
+		void swap(move_only_function & lhs, move_only_function & rhs) noexcept requires(!options::pinned) { lhs.swap(rhs); }
 
 		friend
 		auto operator==(const move_only_function & self, std::nullptr_t) noexcept -> bool { return !self; }
 	};
 
 
-	template<typename Signature>
-	class copyable_function<Signature> final : internal_function::function_call<copyable_function<Signature>, Signature> {
-		using traits = internal_function::traits<Signature>;
-		using vtable = internal_function::vtable<traits>;
-		friend internal_function::function_call<copyable_function, Signature>;
-		friend move_only_function<Signature>;
+	template<typename Signature, typename... Ts>
+	class copyable_function<Signature, Ts...> final : internal_function::function_calls<copyable_function<Signature, Ts...>, typename internal_function::wrapper_config<Signature, Ts...>::signatures> {
+		using config = internal_function::wrapper_config<Signature, Ts...>;
+		using traits = typename config::traits;
+		using options = typename config::options;
+		using vtable_factory = internal_function::vtable_factory<traits, typename config::storage>;
+		using vtable = typename vtable_factory::vtable;
+		template<typename, typename, std::size_t>
+		friend struct internal_function::function_call;
+		friend internal_function_ref::target_access<copyable_function>;
+		friend internal_function::cached_call<copyable_function>;
+		template<typename...>
+		friend class copyable_function;
+		template<typename, typename>
+		friend struct stores_inline;
+		template<typename...>
+		friend class move_only_function;
+		static_assert(!(options::shared && options::trivial), "shared_storage cannot be combined with trivially_relocatable");
+		static_assert(!(options::pinned && options::trivial), "pinned cannot be combined with trivially_relocatable");
 
 		template<typename... T>
 		static
@@ -547,25 +2013,94 @@ namespace p2548 {
 		template<typename VT>
 		static
 		constexpr
-		bool is_callable_from{is_invocable_using<typename traits::template quals<VT>> && is_invocable_using<typename traits::template inv_quals<VT>>};
+		bool is_callable_from{internal_function::is_callable_from<traits, VT> && internal_function::is_storable<VT, typename vtable::storage_t, options> && internal_function::is_shareable<traits, VT, typename vtable::storage_t, options>};
+
+		template<typename T, typename... A>
+		static
+		auto init_functor(typename vtable::storage_t & storage, A &&... args) -> const vtable * {
+			if constexpr(options::shared) return vtable_factory::template init_shared_functor<T>(storage, std::forward<A>(args)...);
+			else return vtable_factory::template init_functor<true, T>(storage, std::forward<A>(args)...);
+		}
+
+		template<typename T, typename Alloc, typename... A>
+		static
+		auto init_allocated_functor(typename vtable::storage_t & storage, const Alloc & alloc, A &&... args) -> const vtable * {
+			if constexpr(options::shared) return vtable_factory::template init_allocated_shared_functor<T>(storage, alloc, std::forward<A>(args)...);
+			else return vtable_factory::template init_allocated_functor<true, T>(storage, alloc, std::forward<A>(args)...);
+		}
+
+		//! @brief checks if the target of wrapper F can be adopted including its vtable, which holds for all qualifier-relaxing conversions
+		template<typename F>
+		static
+		constexpr
+		auto shares_vtable() noexcept -> bool {
+			if constexpr(internal_function::is_copyable_function_specialization_v<F>) return std::is_same_v<vtable, typename F::vtable> && (!options::trivial || F::options::trivial) && !options::pinned;
+			else return false;
+		}
+
+		//! @brief checks if wrapper F only holds inline targets and they are adopted, so converting from it never allocates
+		template<typename F>
+		static
+		constexpr
+		auto adopts_inline() noexcept -> bool {
+			if constexpr(shares_vtable<F>()) return F::options::inplace || F::options::trivial;
+			else return false;
+		}
+
+		//! @brief checks if converting from wrapper F adopts its target, which must not introduce heap-allocated targets into inplace_only wrappers
+		template<typename F>
+		static
+		constexpr
+		auto adoptable() noexcept -> bool {
+			if constexpr(shares_vtable<F>()) return !options::inplace || adopts_inline<F>();
+			else return false;
+		}
+
+		//! @brief checks if the target adopted from wrapper F may be a shared functor that throws when cloned by a noexcept call of this wrapper
+		template<typename F>
+		static
+		constexpr
+		auto checks_unshare() noexcept -> bool {
+			if constexpr(internal_function::is_copyable_function_specialization_v<F>) return traits::clones_noexcept && !F::traits::clones_noexcept && F::options::shared;
+			else return false;
+		}
 
-		const vtable * vptr;
-		internal_function::storage_t storage;
+		alignas(vtable::storage_t::alignment) typename vtable::storage_t storage; //first, so that a compressed vtable index occupies the bytes following it
+		internal_function::vtable_ref<vtable, options::vtable_layout> vptr;
+
+		auto dispatch() const noexcept -> const typename vtable::dispatch_type & { return vptr.dispatch(); }
+		auto context() const noexcept -> void * { return const_cast<typename vtable::storage_t *>(&storage); }
 	public:
 		copyable_function() noexcept : vptr{vtable::init_empty()} {}
 		copyable_function(std::nullptr_t) noexcept : copyable_function{} {}
 
 		template<typename F>
-		requires(!std::is_same_v<copyable_function, std::remove_cvref_t<F>> && !internal_function::is_in_place_type_t_specialization_v<std::remove_cvref_t<F>> && is_callable_from<std::decay_t<F>>)
+		requires(!std::is_same_v<copyable_function, std::remove_cvref_t<F>> && !internal_function::is_in_place_type_t_specialization_v<std::remove_cvref_t<F>> && (is_callable_from<std::decay_t<F>> || adoptable<std::remove_cvref_t<F>>()))
 		copyable_function(F && func) {
 			using VT = std::decay_t<F>;
 			static_assert(std::is_constructible_v<VT, F>);
-			if constexpr(std::is_function_v<std::remove_pointer_t<F>> || std::is_member_pointer_v<F> || internal_function::is_copyable_function_specialization_v<std::remove_cvref_t<F>>)
+			if constexpr(shares_vtable<std::remove_cvref_t<F>>()) { //QoI: prevent double-wrapping
+				if constexpr(checks_unshare<std::remove_cvref_t<F>>())
+					if(func.vptr->has(internal_function::capability::throwing_unshare)) { //invoked through a const signature, the wrapped source never clones its target (copying it only shares it)
+						vptr = init_functor<VT>(storage, std::forward<F>(func));
+						return;
+					}
+				if constexpr(std::is_same_v<F, std::remove_cvref_t<F>>) {
+					vptr = func.vptr.get();
+					func.vptr->destructive_move(&func.storage, &storage);
+					func.vptr = vtable::init_empty();
+				} else {
+					vptr = func.vptr.get();
+					func.vptr->copy(&func.storage, &storage);
+				}
+				return;
+			}
+			if constexpr(std::is_function_v<std::remove_pointer_t<F>> || std::is_member_pointer_v<F> || internal_function::is_copyable_function_specialization_v<std::remove_cvref_t<F>> || internal_function::is_std_function_specialization_v<std::remove_cvref_t<F>>)
 				if(!func) {
 					vptr = vtable::init_empty();
 					return;
 				}
-			vptr = vtable::template init_functor<true, VT>(storage, std::forward<F>(func));
+			vptr = init_functor<VT>(storage, std::forward<F>(func));
 		}
 
 		template<typename T, typename... A>
@@ -573,7 +2108,7 @@ namespace p2548 {
 		explicit
 		copyable_function(std::in_place_type_t<T>, A &&... args) {
 			static_assert(std::is_same_v<T, std::decay_t<T>>);
-			vptr = vtable::template init_functor<true, T>(storage, std::forward<A>(args)...);
+			vptr = init_functor<T>(storage, std::forward<A>(args)...);
 		}
 
 		template<typename T, typename U, typename... A>
@@ -581,56 +2116,433 @@ namespace p2548 {
 		explicit
 		copyable_function(std::in_place_type_t<T>, std::initializer_list<U> ilist, A &&... args) {
 			static_assert(std::is_same_v<T, std::decay_t<T>>);
-			vptr = vtable::template init_functor<true, T>(storage, ilist, std::forward<A>(args)...);
+			vptr = init_functor<T>(storage, ilist, std::forward<A>(args)...);
+		}
+
+		template<auto F>
+		requires(is_invocable_using<decltype(F)>)
+		copyable_function(nontype_t<F>) noexcept {
+			if constexpr(std::is_pointer_v<decltype(F)> || std::is_member_pointer_v<decltype(F)>) static_assert(F != nullptr);
+			vptr = vtable_factory::template init_nontype<F>(storage);
+		}
+
+		template<auto F, typename T>
+		requires(std::is_constructible_v<std::decay_t<T>, T> && internal_function::is_bindable<traits, F, std::decay_t<T>> && internal_function::is_storable<std::decay_t<T>, typename vtable::storage_t, options>)
+		copyable_function(nontype_t<F>, T && obj) {
+			vptr = vtable_factory::template init_bound<true, F, std::decay_t<T>>(storage, std::forward<T>(obj));
+		}
+
+		template<typename Alloc, typename F>
+		requires(!std::is_same_v<copyable_function, std::remove_cvref_t<F>> && !internal_function::is_in_place_type_t_specialization_v<std::remove_cvref_t<F>> && is_callable_from<std::decay_t<F>>)
+		copyable_function(std::allocator_arg_t, const Alloc & alloc, F && func) {
+			using VT = std::decay_t<F>;
+			static_assert(std::is_constructible_v<VT, F>);
+			if constexpr(std::is_function_v<std::remove_pointer_t<F>> || std::is_member_pointer_v<F> || internal_function::is_copyable_function_specialization_v<std::remove_cvref_t<F>> || internal_function::is_std_function_specialization_v<std::remove_cvref_t<F>>)
+				if(!func) {
+					vptr = vtable::init_empty();
+					return;
+				}
+			vptr = init_allocated_functor<VT>(storage, alloc, std::forward<F>(func));
+		}
+
+		template<typename Alloc, typename T, typename... A>
+		requires(std::is_constructible_v<std::decay_t<T>, A &&...> && is_callable_from<std::decay_t<T>>)
+		explicit
+		copyable_function(std::allocator_arg_t, const Alloc & alloc, std::in_place_type_t<T>, A &&... args) {
+			static_assert(std::is_same_v<T, std::decay_t<T>>);
+			vptr = init_allocated_functor<T>(storage, alloc, std::forward<A>(args)...);
+		}
+
+		template<typename Alloc, typename T, typename U, typename... A>
+		requires(std::is_constructible_v<std::decay_t<T>, std::initializer_list<U> &, A &&...> && is_callable_from<std::decay_t<T>>)
+		explicit
+		copyable_function(std::allocator_arg_t, const Alloc & alloc, std::in_place_type_t<T>, std::initializer_list<U> ilist, A &&... args) {
+			static_assert(std::is_same_v<T, std::decay_t<T>>);
+			vptr = init_allocated_functor<T>(storage, alloc, ilist, std::forward<A>(args)...);
 		}
 
-		copyable_function(const copyable_function & other) : vptr{other.vptr} { other.vptr->copy(&other.storage, &storage); }
+		copyable_function(const copyable_function &) requires(options::trivial) =default;
+		copyable_function(const copyable_function & other) requires(!options::trivial) : vptr{other.vptr} { other.vptr->copy(&other.storage, &storage); }
 
-		copyable_function(copyable_function && other) noexcept { vtable::move_ctor(vptr, storage, other.vptr, other.storage); }
+		copyable_function(copyable_function &&) noexcept requires(options::trivial) =default;
+		copyable_function(copyable_function && other) noexcept requires(!options::trivial && !options::pinned) { vtable::move_ctor(vptr, storage, other.vptr, other.storage); }
+		copyable_function(copyable_function &&) requires(options::pinned) =delete;
 
-		auto operator=(const copyable_function & other) -> copyable_function & {
+		auto operator=(const copyable_function &) -> copyable_function & requires(options::trivial) =default;
+		auto operator=(const copyable_function & other) -> copyable_function & requires(!options::trivial) {
 			if(this != &other) {
-				if(other.vptr->noexcept_copyable()) {
+				if(vptr.get() == other.vptr.get() && vptr->assign) vptr->assign(&other.storage, &storage); //QoI: reuse the allocation of the current target
+				else if(other.vptr->noexcept_copyable()) {
+					vptr->dtor(&storage);
+					other.vptr->copy(&other.storage, &storage);
+				} else if constexpr(options::pinned) { //targets cannot be relocated => the wrapper is empty if the copy throws
 					vptr->dtor(&storage);
+					vptr = vtable::init_empty();
 					other.vptr->copy(&other.storage, &storage);
 				} else {
-					internal_function::storage_t tmp;
+					alignas(vtable::storage_t::alignment) typename vtable::storage_t tmp;
 					other.vptr->copy(&other.storage, &tmp);
 					vptr->dtor(&storage);
-					other.vptr->move(&tmp, &storage);
+					other.vptr->destructive_move(&tmp, &storage);
 				}
 				vptr = other.vptr;
 			}
 			return *this;
 		}
 
-		auto operator=(copyable_function && other) noexcept -> copyable_function & {
+		auto operator=(copyable_function &&) noexcept -> copyable_function & requires(options::trivial) =default;
+		auto operator=(copyable_function &&) -> copyable_function & requires(options::pinned) =delete;
+		auto operator=(copyable_function && other) noexcept -> copyable_function & requires(!options::trivial && !options::pinned) {
 			vtable::move_assign(vptr, storage, other.vptr, other.storage);
 			return *this;
 		}
 		auto operator=(std::nullptr_t) noexcept -> copyable_function & {
-			if(*this) copyable_function{}.swap(*this);
+			vptr->dtor(&storage);
+			vptr = vtable::init_empty();
 			return *this;
 		}
 
 		template<typename F>
-		auto operator=(F && func) -> copyable_function & {
-			copyable_function{std::forward<F>(func)}.swap(*this);
-			return *this;
+		requires(!std::is_same_v<copyable_function, std::remove_cvref_t<F>> && !options::pinned) //non-const lvalues use the copy assignment operator
+		auto operator=(F && func) -> copyable_function & { return *this = copyable_function{std::forward<F>(func)}; } //strong exception guarantee, relocates the new target once
+
+		//! @brief destroys the current target and constructs a T in its place, reusing its heap block if it is of the same size class
+		//! @note the wrapper is empty if the construction throws, args must not refer to the current target
+		template<typename T, typename... A>
+		requires(std::is_constructible_v<std::decay_t<T>, A &&...> && is_callable_from<std::decay_t<T>>)
+		void emplace(A &&... args) {
+			static_assert(std::is_same_v<T, std::decay_t<T>>);
+			const auto & old{*vptr.get()};
+			vptr = vtable::init_empty();
+			if constexpr(options::shared) {
+				old.dtor(&storage);
+				vptr = init_functor<T>(storage, std::forward<A>(args)...);
+			} else vptr = vtable_factory::template reinit_functor<true, T>(old, storage, std::forward<A>(args)...);
 		}
 
-		~copyable_function() noexcept { vptr->dtor(&storage); }
+		~copyable_function() noexcept requires(options::trivial) =default;
+		~copyable_function() noexcept requires(!options::trivial) { vptr->dtor(&storage); }
 
-		using internal_function::function_call<copyable_function, Signature>::operator();
+		using internal_function::function_calls<copyable_function, typename config::signatures>::operator();
 
 		explicit
-		operator bool() const noexcept { return vptr->dispatch; }
+		operator bool() const noexcept { return internal_function::has_target(vptr.dispatch()); }
+
+#if defined(__cpp_rtti) || defined(__GXX_RTTI) || defined(_CPPRTTI)
+		//! @returns type of the stored target or typeid(void) if empty
+		//! @note function pointers are stored as the plain function pointer type of the signature if convertible
+		auto target_type() const noexcept -> const std::type_info & { return vptr->type->info; }
+#endif
+
+		//! @returns pointer to the stored target if it is of type T, nullptr otherwise
+		//! @note compares the type tag of the vtable, so no RTTI is required
+		template<typename T>
+		requires(std::is_object_v<T>)
+		auto target() const noexcept -> const T * { return vptr->template target<T>(&storage); }
+		//! @throws if a shared target must be copied to grant mutable access
+		template<typename T>
+		requires(std::is_object_v<T>)
+		auto target() -> T * { return vptr->template target<T>(&storage); }
 
-		void swap(copyable_function & other) noexcept { vtable::swap(vptr, storage, other.vptr, other.storage); }
+		void swap(copyable_function & other) noexcept requires(!options::pinned) { vtable::swap(vptr, storage, other.vptr, other.storage); }
 		friend
-		void swap(copyable_function & lhs, copyable_function & rhs) noexcept { lhs.swap(rhs); }
+		void swap(copyable_function & lhs, copyable_function & rhs) noexcept requires(!options::pinned) { lhs.swap(rhs); }
 
 		friend
 		auto operator==(const copyable_function & self, std::nullptr_t) noexcept -> bool { return !self; }
 	};
+
+
+	template<typename Signature, typename... Ts>
+	class compact_move_only_function<Signature, Ts...> final : internal_function::function_calls<compact_move_only_function<Signature, Ts...>, typename internal_function::wrapper_config<Signature, Ts...>::signatures> {
+		using config = internal_function::wrapper_config<Signature, Ts...>;
+		using traits = typename config::traits;
+		using factory = internal_function::compact_factory<traits>;
+		using vtable = typename factory::vtable;
+		template<typename, typename, std::size_t>
+		friend struct internal_function::function_call;
+		static_assert(config::arguments::policies::size == 0, "compact_move_only_function does not support policies");
+
+		template<typename... T>
+		static
+		constexpr
+		bool is_invocable_using{traits::template is_invocable_using<T...>};
+
+		template<typename VT>
+		static
+		constexpr
+		bool is_callable_from{internal_function::is_callable_from<traits, VT>};
+
+		//! @brief function pointers are stored in the handle itself, unless their address uses the tag bit
+		static
+		constexpr
+		std::uintptr_t function_pointer_tag{1};
+
+		std::uintptr_t handle; //0 if empty, a tagged function pointer or the address of the header of the functor
+
+		auto header() const noexcept -> internal_function::compact_header * { return reinterpret_cast<internal_function::compact_header *>(handle); }
+
+		auto dispatch() const noexcept -> const typename vtable::dispatch_type & {
+			if constexpr(requires { typename traits::function_pointer; }) if(handle & function_pointer_tag) return factory::function_pointer_vtable()->dispatch;
+			return static_cast<const vtable *>(header()->vtable)->dispatch;
+		}
+		auto context() const noexcept -> void * { return reinterpret_cast<void *>(handle & ~function_pointer_tag); }
+
+		template<typename T>
+		static
+		constexpr
+		auto encodable() noexcept -> bool {
+			if constexpr(requires { typename traits::function_pointer; }) return std::is_same_v<T, typename traits::function_pointer>;
+			else return false;
+		}
+
+		template<typename T, typename Alloc, typename... A>
+		static
+		auto make([[maybe_unused]] const Alloc * alloc, A &&... args) -> std::uintptr_t {
+			if constexpr(std::is_void_v<Alloc>) return reinterpret_cast<std::uintptr_t>(factory::template functor<T>(std::forward<A>(args)...));
+			else return reinterpret_cast<std::uintptr_t>(factory::template allocated_functor<T>(*alloc, std::forward<A>(args)...));
+		}
+
+		template<typename T, typename Alloc, typename... A>
+		void init(const Alloc * alloc, A &&... args) {
+			using U = typename internal_function::canonical_target<traits, T>::type;
+			if constexpr(encodable<U>()) {
+				const U ptr{std::forward<A>(args)...};
+				const auto address{reinterpret_cast<std::uintptr_t>(ptr)};
+				handle = address & function_pointer_tag ? make<U>(alloc, ptr) : address | function_pointer_tag; //rare: the address uses the tag bit
+			} else handle = make<U>(alloc, std::forward<A>(args)...);
+		}
+
+		template<typename F>
+		static
+		constexpr
+		bool nullable{std::is_function_v<std::remove_pointer_t<F>> || std::is_member_pointer_v<F> || internal_function::is_move_only_function_specialization_v<std::remove_cvref_t<F>> || internal_function::is_copyable_function_specialization_v<std::remove_cvref_t<F>> || internal_function::is_std_function_specialization_v<std::remove_cvref_t<F>> || internal_function::is_compact_move_only_function_specialization_v<std::remove_cvref_t<F>>};
+	public:
+		compact_move_only_function() noexcept : handle{0} {}
+		compact_move_only_function(std::nullptr_t) noexcept : compact_move_only_function{} {}
+
+		template<typename F>
+		requires(!std::is_same_v<compact_move_only_function, std::remove_cvref_t<F>> && !internal_function::is_in_place_type_t_specialization_v<std::remove_cvref_t<F>> && is_callable_from<std::decay_t<F>>)
+		compact_move_only_function(F && func) : handle{0} {
+			static_assert(std::is_constructible_v<std::decay_t<F>, F>);
+			if constexpr(nullable<F>) if(!func) return;
+			init<std::decay_t<F>>(static_cast<const void *>(nullptr), std::forward<F>(func));
+		}
+
+		template<typename T, typename... A>
+		requires(std::is_constructible_v<std::decay_t<T>, A &&...> && is_callable_from<std::decay_t<T>>)
+		explicit
+		compact_move_only_function(std::in_place_type_t<T>, A &&... args) {
+			static_assert(std::is_same_v<T, std::decay_t<T>>);
+			init<T>(static_cast<const void *>(nullptr), std::forward<A>(args)...);
+		}
+
+		template<typename T, typename U, typename... A>
+		requires(std::is_constructible_v<std::decay_t<T>, std::initializer_list<U> &, A &&...> && is_callable_from<std::decay_t<T>>)
+		explicit
+		compact_move_only_function(std::in_place_type_t<T>, std::initializer_list<U> ilist, A &&... args) {
+			static_assert(std::is_same_v<T, std::decay_t<T>>);
+			init<T>(static_cast<const void *>(nullptr), ilist, std::forward<A>(args)...);
+		}
+
+		template<auto F>
+		requires(is_invocable_using<decltype(F)>)
+		compact_move_only_function(nontype_t<F>) noexcept : handle{reinterpret_cast<std::uintptr_t>(factory::template nontype<F>())} {
+			if constexpr(std::is_pointer_v<decltype(F)> || std::is_member_pointer_v<decltype(F)>) static_assert(F != nullptr);
+		}
+
+		template<auto F, typename T>
+		requires(std::is_constructible_v<std::decay_t<T>, T> && internal_function::is_bindable<traits, F, std::decay_t<T>>)
+		compact_move_only_function(nontype_t<F>, T && obj) : handle{reinterpret_cast<std::uintptr_t>(factory::template bound<F, std::decay_t<T>>(std::forward<T>(obj)))} {}
+
+		template<typename Alloc, typename F>
+		requires(!std::is_same_v<compact_move_only_function, std::remove_cvref_t<F>> && !internal_function::is_in_place_type_t_specialization_v<std::remove_cvref_t<F>> && is_callable_from<std::decay_t<F>>)
+		compact_move_only_function(std::allocator_arg_t, const Alloc & alloc, F && func) : handle{0} {
+			static_assert(std::is_constructible_v<std::decay_t<F>, F>);
+			if constexpr(nullable<F>) if(!func) return;
+			init<std::decay_t<F>>(&alloc, std::forward<F>(func));
+		}
+
+		template<typename Alloc, typename T, typename... A>
+		requires(std::is_constructible_v<std::decay_t<T>, A &&...> && is_callable_from<std::decay_t<T>>)
+		explicit
+		compact_move_only_function(std::allocator_arg_t, const Alloc & alloc, std::in_place_type_t<T>, A &&... args) {
+			static_assert(std::is_same_v<T, std::decay_t<T>>);
+			init<T>(&alloc, std::forward<A>(args)...);
+		}
+
+		template<typename Alloc, typename T, typename U, typename... A>
+		requires(std::is_constructible_v<std::decay_t<T>, std::initializer_list<U> &, A &&...> && is_callable_from<std::decay_t<T>>)
+		explicit
+		compact_move_only_function(std::allocator_arg_t, const Alloc & alloc, std::in_place_type_t<T>, std::initializer_list<U> ilist, A &&... args) {
+			static_assert(std::is_same_v<T, std::decay_t<T>>);
+			init<T>(&alloc, ilist, std::forward<A>(args)...);
+		}
+
+		compact_move_only_function(const compact_move_only_function &) =delete;
+		compact_move_only_function(compact_move_only_function && other) noexcept : handle{std::exchange(other.handle, 0)} {}
+
+		auto operator=(const compact_move_only_function &) -> compact_move_only_function & =delete;
+		auto operator=(compact_move_only_function && other) noexcept -> compact_move_only_function & {
+			compact_move_only_function tmp{std::move(other)};
+			swap(tmp);
+			return *this;
+		}
+		auto operator=(std::nullptr_t) noexcept -> compact_move_only_function & {
+			compact_move_only_function tmp;
+			swap(tmp);
+			return *this;
+		}
+
+		template<typename F>
+		auto operator=(F && func) -> compact_move_only_function & { return *this = compact_move_only_function{std::forward<F>(func)}; }
+
+		~compact_move_only_function() noexcept {
+			if(!handle || (handle & function_pointer_tag)) return;
+			if(const auto destroy{static_cast<const vtable *>(header()->vtable)->destroy}) destroy(header());
+		}
+
+		using internal_function::function_calls<compact_move_only_function, typename config::signatures>::operator();
+
+		explicit
+		operator bool() const noexcept { return handle != 0; }
+
+		void swap(compact_move_only_function & other) noexcept { std::swap(handle, other.handle); }
+		friend
+		void swap(compact_move_only_function & lhs, compact_move_only_function & rhs) noexcept { lhs.swap(rhs); }
+
+		friend
+		auto operator==(const compact_move_only_function & self, std::nullptr_t) noexcept -> bool { return !self; }
+	};
+
+
+	namespace internal_function_ref {
+		template<typename... Signature>
+		struct target_access<move_only_function<Signature...>> final {
+			static
+			constexpr
+			bool enabled{true};
+
+			static
+			auto context(const move_only_function<Signature...> & func) noexcept -> void * { return func.context(); }
+
+			static
+			auto dispatch(const move_only_function<Signature...> & func) noexcept {
+				using traits = typename move_only_function<Signature...>::traits;
+				if constexpr(std::is_pointer_v<typename traits::dispatch_type>) return internal_function::select_dispatch<traits, 0>(func.vptr.dispatch());
+				else return func.vptr.dispatch(); //multiple signatures are never bound directly
+			}
+		};
+
+		template<typename... Signature>
+		struct target_access<copyable_function<Signature...>> final {
+			static
+			constexpr
+			bool enabled{true};
+
+			static
+			auto context(const copyable_function<Signature...> & func) noexcept -> void * { return func.context(); }
+
+			static
+			auto dispatch(const copyable_function<Signature...> & func) noexcept {
+				using traits = typename copyable_function<Signature...>::traits;
+				if constexpr(std::is_pointer_v<typename traits::dispatch_type>) return internal_function::select_dispatch<traits, 0>(func.vptr.dispatch());
+				else return func.vptr.dispatch(); //multiple signatures are never bound directly
+			}
+		};
+	}
+
+	namespace internal_function {
+		template<typename Wrapper>
+		struct cached_call final {
+			using traits = typename Wrapper::traits;
+			static_assert(std::is_pointer_v<typename traits::dispatch_type>, "cached invocation requires a wrapper with a single signature");
+
+			//! @brief types that cannot be stored in the wrapper are never a target and are skipped
+			template<typename T>
+			static
+			constexpr
+			bool candidate{Wrapper::template is_callable_from<T>};
+
+			//! @brief checks if the target is invoked with the qualifiers of Wrapper, targets adopted from other wrappers keep dispatching with those of their source
+			template<typename T>
+			static
+			auto dispatches_directly(const Wrapper & self) noexcept -> bool {
+				using storage_t = typename Wrapper::vtable::storage_t;
+				const typename traits::erased_dispatch_type dispatch{self.dispatch()};
+				if(dispatch == traits::template functor_dispatch<storage_t, T, sbo<T, storage_t>>) return true;
+				if constexpr(!sbo<T, storage_t>) return dispatch == traits::template shared_dispatch<storage_t, T, void>;
+				else return false;
+			}
+
+			template<typename T, typename Self>
+			static
+			auto target(Self & self) {
+				if constexpr(traits::is_const) return dispatches_directly<T>(self) ? std::as_const(self).template target<T>() : nullptr; //const access never unshares
+				else return dispatches_directly<T>(self) ? self.template target<T>() : nullptr;
+			}
+
+			template<typename T, typename... Ts, typename Self, typename... A>
+			static
+			auto invoke(Self && self, A &&... args) -> decltype(auto) {
+				if constexpr(candidate<T>) if(const auto ptr{target<T>(self)}) return traits::template direct<T>(*ptr, std::forward<A>(args)...);
+				if constexpr(sizeof...(Ts) == 0) return std::forward<Self>(self)(std::forward<A>(args)...);
+				else return invoke<Ts...>(std::forward<Self>(self), std::forward<A>(args)...);
+			}
+
+			//! @returns index of the type of the target in T... or sizeof...(T) if not found
+			template<typename... T>
+			static
+			auto find(const Wrapper & self) noexcept -> std::size_t {
+				std::size_t index{0};
+				(void)((self.template target<T>() == nullptr && (++index, true)) && ...);
+				return index;
+			}
+		};
+	}
+
+
+	//! @brief invokes an owning wrapper, calling its target directly if it is of one of the expected types T...
+	//! @note each expected type costs a predictable comparison, a hit replaces the indirect call with an inlinable direct one
+	template<typename... T, typename Function, typename... Args>
+	requires(sizeof...(T) > 0 && (internal_function::is_move_only_function_specialization_v<std::remove_cvref_t<Function>> || internal_function::is_copyable_function_specialization_v<std::remove_cvref_t<Function>>))
+	auto cached_invoke(Function && func, Args &&... args) -> decltype(auto) { return internal_function::cached_call<std::remove_cvref_t<Function>>::template invoke<T...>(std::forward<Function>(func), std::forward<Args>(args)...); }
+
+
+	//! @brief call site cache for owning wrappers that learns which of the expected types T... dominates at runtime and checks it exclusively
+	//! @note switches to another expected type after other expected types were encountered a number of times since the dominant one last matched (unexpected targets are not counted)
+	template<typename... T>
+	class call_site_cache final {
+		static_assert(sizeof...(T) > 0 && sizeof...(T) < 256);
+
+		static
+		constexpr
+		unsigned char threshold{16};
+
+		unsigned char dominant{0};
+		unsigned char misses{0};
+
+		template<std::size_t I, typename Function, typename... Args>
+		auto invoke(Function && func, Args &&... args) -> decltype(auto) {
+			if constexpr(I + 1 < sizeof...(T)) if(dominant != I) return invoke<I + 1>(std::forward<Function>(func), std::forward<Args>(args)...);
+
+			using access = internal_function::cached_call<std::remove_cvref_t<Function>>;
+			using U = std::tuple_element_t<I, std::tuple<T...>>;
+			if constexpr(access::template candidate<U>)
+				if(const auto ptr{access::template target<U>(func)}) {
+					misses = 0;
+					return access::traits::template direct<U>(*ptr, std::forward<Args>(args)...);
+				}
+
+			if(const auto index{access::template find<T...>(func)}; index != sizeof...(T) && ++misses == threshold) {
+				dominant = static_cast<unsigned char>(index);
+				misses = 0;
+			}
+			return std::forward<Function>(func)(std::forward<Args>(args)...);
+		}
+	public:
+		template<typename Function, typename... Args>
+		requires(internal_function::is_move_only_function_specialization_v<std::remove_cvref_t<Function>> || internal_function::is_copyable_function_specialization_v<std::remove_cvref_t<Function>>)
+		auto operator()(Function && func, Args &&... args) -> decltype(auto) { return invoke<0>(std::forward<Function>(func), std::forward<Args>(args)...); }
+	};
 }
@@ -5,17 +5,48 @@
 //          http://www.boost.org/LICENSE_1_0.txt)
 
 #pragma once
+#include <span>
 #include <utility>
+#include <string_view>
 #include <type_traits>
+#include "nontype.hpp"
 
 namespace p2548 {
 	static_assert(sizeof(void *) == sizeof(void(*)()));
 	static_assert(sizeof(void *) == sizeof(void(*)() noexcept));
 
+	//! @brief opt-in for class types to cross the type-erased boundary of all wrappers by value (i.e. in registers) instead of by reference
+	//! @tparam T small trivially copyable parameter type, the specialization must be visible wherever T is used in a signature
+	template<typename T>
+	struct pass_by_value : std::false_type {};
+
+	template<typename CharT, typename Traits>
+	struct pass_by_value<std::basic_string_view<CharT, Traits>> : std::true_type {};
+
+	template<typename T, std::size_t Extent>
+	struct pass_by_value<std::span<T, Extent>> : std::true_type {};
+
+
 	namespace internal_function_ref {
 		template<typename T>
 		using remove_cvref_t = std::remove_cv_t<std::remove_reference_t<T>>; //TODO: [C++20] replace with std::remove_cvref_t
 
+		//! @note class types are only passed by value on request, as they may still be incomplete where the signature is first used (and must not change the erased signature)
+		template<typename T>
+		constexpr
+		auto by_value() noexcept -> bool {
+			if constexpr(std::is_reference_v<T> || std::is_scalar_v<T>) return true;
+			else if constexpr(p2548::pass_by_value<std::remove_cv_t<T>>::value) {
+				static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable types may be passed by value");
+				return true;
+			} else return false;
+		}
+
+		//! @brief type of a parameter crossing the type-erased boundary: references, scalars and pass_by_value types are passed as declared, everything else as reference to the caller's parameter (avoiding an additional move)
+		template<typename T>
+		using param_t = std::conditional_t<by_value<T>(), T, T &&>;
+
+
 		template<typename>
 		struct traits;
 
@@ -23,11 +54,23 @@ namespace p2548 {
 		struct traits<Result(Args...)> final {
 			using const_ = std::false_type;
 			using noexcept_ = std::false_type;
-			using dispatch_type = Result(*)(void *, Args...);
+			using dispatch_type = Result(*)(void *, param_t<Args>...);
 
 			template<typename T>
 			static
-			auto functor(void * ctx, Args... args) -> Result { return std::invoke_r<Result>(*reinterpret_cast<T *>(ctx), std::forward<Args>(args)...); }
+			auto functor(void * ctx, param_t<Args>... args) -> Result { return std::invoke_r<Result>(*reinterpret_cast<T *>(ctx), std::forward<Args>(args)...); }
+
+			template<auto F>
+			static
+			auto nontype_functor(void *, param_t<Args>... args) -> Result { return std::invoke_r<Result>(F, std::forward<Args>(args)...); }
+
+			template<auto F, typename T>
+			static
+			auto bound_functor(void * ctx, param_t<Args>... args) -> Result { return std::invoke_r<Result>(F, *static_cast<T *>(ctx), std::forward<Args>(args)...); }
+
+			template<auto F, typename T>
+			static
+			auto pointer_functor(void * ctx, param_t<Args>... args) -> Result { return std::invoke_r<Result>(F, static_cast<T *>(ctx), std::forward<Args>(args)...); }
 
 			template<typename... T>
 			static
@@ -39,11 +82,23 @@ namespace p2548 {
 		struct traits<Result(Args...) const> final {
 			using const_ = std::true_type;
 			using noexcept_ = std::false_type;
-			using dispatch_type = Result(*)(void *, Args...);
+			using dispatch_type = Result(*)(void *, param_t<Args>...);
 
 			template<typename T>
 			static
-			auto functor(void * ctx, Args... args) -> Result { return std::invoke_r<Result>(*reinterpret_cast<const T *>(ctx), std::forward<Args>(args)...); }
+			auto functor(void * ctx, param_t<Args>... args) -> Result { return std::invoke_r<Result>(*reinterpret_cast<const T *>(ctx), std::forward<Args>(args)...); }
+
+			template<auto F>
+			static
+			auto nontype_functor(void *, param_t<Args>... args) -> Result { return std::invoke_r<Result>(F, std::forward<Args>(args)...); }
+
+			template<auto F, typename T>
+			static
+			auto bound_functor(void * ctx, param_t<Args>... args) -> Result { return std::invoke_r<Result>(F, *static_cast<T *>(ctx), std::forward<Args>(args)...); }
+
+			template<auto F, typename T>
+			static
+			auto pointer_functor(void * ctx, param_t<Args>... args) -> Result { return std::invoke_r<Result>(F, static_cast<T *>(ctx), std::forward<Args>(args)...); }
 
 			template<typename... T>
 			static
@@ -55,11 +110,23 @@ namespace p2548 {
 		struct traits<Result(Args...) noexcept> final {
 			using const_ = std::false_type;
 			using noexcept_ = std::true_type;
-			using dispatch_type = Result(*)(void *, Args...) noexcept;
+			using dispatch_type = Result(*)(void *, param_t<Args>...) noexcept;
 
 			template<typename T>
 			static
-			auto functor(void * ctx, Args... args) noexcept -> Result { return std::invoke_r<Result>(*reinterpret_cast<T *>(ctx), std::forward<Args>(args)...); }
+			auto functor(void * ctx, param_t<Args>... args) noexcept -> Result { return std::invoke_r<Result>(*reinterpret_cast<T *>(ctx), std::forward<Args>(args)...); }
+
+			template<auto F>
+			static
+			auto nontype_functor(void *, param_t<Args>... args) noexcept -> Result { return std::invoke_r<Result>(F, std::forward<Args>(args)...); }
+
+			template<auto F, typename T>
+			static
+			auto bound_functor(void * ctx, param_t<Args>... args) noexcept -> Result { return std::invoke_r<Result>(F, *static_cast<T *>(ctx), std::forward<Args>(args)...); }
+
+			template<auto F, typename T>
+			static
+			auto pointer_functor(void * ctx, param_t<Args>... args) noexcept -> Result { return std::invoke_r<Result>(F, static_cast<T *>(ctx), std::forward<Args>(args)...); }
 
 			template<typename... T>
 			static
@@ -71,11 +138,23 @@ namespace p2548 {
 		struct traits<Result(Args...) const noexcept> final {
 			using const_ = std::true_type;
 			using noexcept_ = std::true_type;
-			using dispatch_type = Result(*)(void *, Args...) noexcept;
+			using dispatch_type = Result(*)(void *, param_t<Args>...) noexcept;
 
 			template<typename T>
 			static
-			auto functor(void * ctx, Args... args) noexcept -> Result { return std::invoke_r<Result>(*reinterpret_cast<const T *>(ctx), std::forward<Args>(args)...); }
+			auto functor(void * ctx, param_t<Args>... args) noexcept -> Result { return std::invoke_r<Result>(*reinterpret_cast<const T *>(ctx), std::forward<Args>(args)...); }
+
+			template<auto F>
+			static
+			auto nontype_functor(void *, param_t<Args>... args) noexcept -> Result { return std::invoke_r<Result>(F, std::forward<Args>(args)...); }
+
+			template<auto F, typename T>
+			static
+			auto bound_functor(void * ctx, param_t<Args>... args) noexcept -> Result { return std::invoke_r<Result>(F, *static_cast<T *>(ctx), std::forward<Args>(args)...); }
+
+			template<auto F, typename T>
+			static
+			auto pointer_functor(void * ctx, param_t<Args>... args) noexcept -> Result { return std::invoke_r<Result>(F, static_cast<T *>(ctx), std::forward<Args>(args)...); }
 
 			template<typename... T>
 			static
@@ -84,6 +163,22 @@ namespace p2548 {
 		};
 
 
+		//! @brief customization point for owning function wrappers to expose the type-erased context and dispatch function of their target
+		template<typename T>
+		struct target_access final {
+			static
+			constexpr
+			bool enabled{false};
+		};
+
+		template<typename T, typename Dispatch>
+		constexpr
+		auto binds_target() noexcept -> bool {
+			if constexpr(target_access<std::remove_cv_t<T>>::enabled) return std::is_convertible_v<decltype(target_access<std::remove_cv_t<T>>::dispatch(std::declval<T &>())), Dispatch>;
+			else return false;
+		}
+
+
 		template<typename Impl, typename Signature>
 		struct function_call;
 
@@ -144,6 +239,10 @@ namespace p2548 {
 		static
 		constexpr
 		bool is_invocable_using{traits::template is_invocable_using<T...>};
+
+		template<typename T>
+		static
+		auto erase(T * obj) noexcept -> void * { return const_cast<void *>(static_cast<const void *>(obj)); }
 	public:
 		template<typename F>
 		requires(std::is_function_v<F> && is_invocable_using<F>)
@@ -156,8 +255,39 @@ namespace p2548 {
 		template<typename F, typename T = std::remove_reference_t<F>>
 		requires(!std::is_same_v<function_ref, internal_function_ref::remove_cvref_t<F>> && !std::is_member_pointer_v<T> && is_invocable_using<const_<T> &>)
 		function_ref(F && func) noexcept {
-			ptr = reinterpret_cast<void *>(std::addressof(func));
-			dispatch = traits::template functor<T>;
+			if constexpr(internal_function_ref::binds_target<T, typename traits::dispatch_type>()) { //QoI: bind directly to the target of an owning wrapper, skipping its call operator
+				using access = internal_function_ref::target_access<std::remove_cv_t<T>>;
+				ptr = access::context(func); //refers to the target of func: dangles once func is reassigned, emplaced into or moved from
+				dispatch = access::dispatch(func);
+			} else {
+				ptr = erase(std::addressof(func));
+				dispatch = traits::template functor<T>;
+			}
+		}
+
+		template<auto F>
+		requires(is_invocable_using<decltype(F)>)
+		function_ref(nontype_t<F>) noexcept {
+			if constexpr(std::is_pointer_v<decltype(F)> || std::is_member_pointer_v<decltype(F)>) static_assert(F != nullptr);
+			ptr = nullptr;
+			dispatch = traits::template nontype_functor<F>;
+		}
+
+		template<auto F, typename U, typename T = std::remove_reference_t<U>>
+		requires(!std::is_rvalue_reference_v<U &&> && is_invocable_using<decltype(F), const_<T> &>)
+		function_ref(nontype_t<F>, U && obj) noexcept {
+			if constexpr(std::is_pointer_v<decltype(F)> || std::is_member_pointer_v<decltype(F)>) static_assert(F != nullptr);
+			ptr = erase(std::addressof(obj));
+			dispatch = traits::template bound_functor<F, const_<T>>;
+		}
+
+		template<auto F, typename T>
+		requires(is_invocable_using<decltype(F), const_<T> *>)
+		function_ref(nontype_t<F>, T * obj) noexcept {
+			if constexpr(std::is_pointer_v<decltype(F)> || std::is_member_pointer_v<decltype(F)>) static_assert(F != nullptr);
+			//TODO: [C++??] precondition(obj) if F is a member pointer
+			ptr = erase(obj);
+			dispatch = traits::template pointer_functor<F, const_<T>>;
 		}
 
 		constexpr
@@ -213,5 +343,12 @@ namespace p2548 {
 		struct deduce_signature<Result(*)(Class, Args...) noexcept> final { using type = Result(Args...) noexcept; };
 	}
 
+	template<auto F>
+	requires(std::is_function_v<std::remove_pointer_t<decltype(F)>>)
+	function_ref(nontype_t<F>) -> function_ref<std::remove_pointer_t<decltype(F)>>;
+
+	template<auto F, typename T>
+	function_ref(nontype_t<F>, T &&) -> function_ref<typename internal_function_ref::deduce_signature<decltype(F)>::type>;
+
 	//TODO: static_assert(sizeof(function_ref<T>) == 2 * sizeof(void *));
 }
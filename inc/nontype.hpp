@@ -0,0 +1,28 @@
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#include <utility>
+#include <version> //__cpp_lib_function_ref must be known before deciding which nontype_t to use
+
+namespace p2548 {
+#if defined(__cpp_lib_function_ref)
+	using std::nontype_t;
+	using std::nontype;
+#else
+	//! @brief tag to pass a function (pointer) as a constant template argument, allowing function wrappers to call it directly
+	//! @tparam V function pointer, member pointer or stateless functor
+	template<auto V>
+	struct nontype_t final {
+		explicit
+		nontype_t() =default;
+	};
+
+	template<auto V>
+	inline
+	constexpr
+	nontype_t<V> nontype{};
+#endif
+}
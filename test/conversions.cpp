@@ -39,3 +39,72 @@ TEST_CASE("function_ref", "[conversion] [function_ref]") {
 	p2548::move_only_function<Signature>{p2548::function_ref<Signature>{func}};
 	p2548::copyable_function<Signature>{p2548::function_ref<Signature>{func}};
 }
+
+TEST_CASE("function_ref from owning wrapper", "[conversion] [function_ref]") {
+	struct counter {
+		int count{0};
+		auto operator()(int step) -> int { return count += step; }
+	};
+
+	p2548::move_only_function<int(int)> f0{counter{}};
+	const p2548::function_ref<int(int)> r0{f0};
+	REQUIRE(r0(1) == 1);
+	REQUIRE(r0(2) == 3);
+	REQUIRE(f0(3) == 6);
+
+	const p2548::copyable_function<int(int) const> f1{[](int value) { return value * 2; }};
+	const p2548::function_ref<int(int) const> r1{f1};
+	REQUIRE(r1(2) == 4);
+
+	p2548::copyable_function<int(int), p2548::shared_storage, p2548::inline_capacity<sizeof(void *)>> f2{counter{}};
+	const auto f3{f2};
+	const p2548::function_ref<int(int)> r2{f2};
+	REQUIRE(r2(1) == 1); //copy-on-write detaches f2 from f3
+	REQUIRE(f2(1) == 2);
+
+	p2548::move_only_function<int(int) noexcept, p2548::inline_dispatch> f4{[](int value) noexcept { return value + 1; }};
+	const p2548::function_ref<int(int)> r4{f4};
+	REQUIRE(r4(1) == 2);
+
+	const p2548::function_ref<long(int)> r5{f0}; //different signature => calls through the wrapper
+	REQUIRE(r5(4) == 10);
+}
+
+TEST_CASE("qualifier-relaxing conversion", "[conversion] [move_only_function] [copyable_function]") {
+	struct small {
+		auto operator()() const noexcept -> const void * { return this; }
+	};
+	const auto is_inline{[](const auto & func, const void * target) { //wrapping would allocate the inner wrapper on the heap
+		const auto begin{reinterpret_cast<const char *>(&func)};
+		return target >= begin && target < begin + sizeof(func);
+	}};
+
+	p2548::move_only_function<const void *() const noexcept> f0{small{}};
+	p2548::move_only_function<const void *()> f1{std::move(f0)}; //adopts the target instead of wrapping f0
+	REQUIRE(!f0);
+	REQUIRE(is_inline(f1, f1()));
+
+	p2548::move_only_function<const void *() &&, p2548::inline_dispatch> f2{std::move(f1)};
+	REQUIRE(!f1);
+	const auto target{std::move(f2)()};
+	REQUIRE(is_inline(f2, target));
+
+	p2548::copyable_function<const void *() const noexcept> c0{small{}};
+	p2548::copyable_function<const void *()> c1{std::move(c0)};
+	REQUIRE(!c0);
+	REQUIRE(is_inline(c1, c1()));
+
+	p2548::copyable_function<const void *()> c2{c1};
+	REQUIRE(is_inline(c2, c2()));
+
+	p2548::move_only_function<const void *()> f3{c2};
+	REQUIRE(is_inline(f3, f3()));
+
+	p2548::move_only_function<const void *() const noexcept> f4;
+	p2548::move_only_function<const void *()> f5{std::move(f4)};
+	REQUIRE(!f5);
+
+	p2548::move_only_function<int() const noexcept> f6{[] noexcept { return 42; }};
+	p2548::move_only_function<long()> f7{std::move(f6)}; //different return type => wraps f6
+	REQUIRE(f7() == 42);
+}
@@ -5,6 +5,8 @@
 //          http://www.boost.org/LICENSE_1_0.txt)
 
 #include <catch.hpp>
+#include <string_view>
+#include <memory_resource>
 #include <copyable_function.hpp>
 
 namespace {
@@ -360,6 +362,452 @@ namespace {
 		REQUIRE(f19);
 		REQUIRE(f19() == 17);
 	}
+
+	template<template<typename...> typename Function>
+	void test_inline_capacity() {
+		struct functor {
+			void * ptrs[4];
+			auto operator()() const noexcept -> const void * { return this; }
+		};
+
+		const auto is_inline{[](const auto & func) {
+			const auto target{static_cast<const char *>(func())};
+			const auto self{reinterpret_cast<const char *>(std::addressof(func))};
+			return target >= self && target < self + sizeof(func);
+		}};
+
+		static_assert(sizeof(Function<const void *() const>) == 4 * sizeof(void *));
+		static_assert(sizeof(Function<const void *() const, p2548::inline_capacity<64>>) == 64 + sizeof(void *));
+		static_assert(sizeof(Function<const void *() const, p2548::inline_capacity<sizeof(void *)>>) == 2 * sizeof(void *));
+
+		Function<const void *() const> f0{functor{}};
+		REQUIRE(!is_inline(f0));
+
+		Function<const void *() const, p2548::inline_capacity<64>> f1{functor{}};
+		REQUIRE(is_inline(f1));
+
+		Function<const void *() const, p2548::inline_capacity<64>> f2{std::move(f1)};
+		REQUIRE(!f1);
+		REQUIRE(is_inline(f2));
+
+		Function<const void *() const, p2548::inline_capacity<64>> f3;
+		swap(f2, f3);
+		REQUIRE(!f2);
+		REQUIRE(is_inline(f3));
+	}
+
+	template<template<typename...> typename Function>
+	void test_inline_alignment() {
+		struct alignas(32) functor {
+			float lanes[8];
+			auto operator()() const noexcept -> const void * { return this; }
+		};
+
+		const auto is_aligned{[](const void * ptr) { return reinterpret_cast<std::uintptr_t>(ptr) % 32 == 0; }};
+		const auto is_inline{[](const auto & func) {
+			const auto target{static_cast<const char *>(func())};
+			const auto self{reinterpret_cast<const char *>(std::addressof(func))};
+			return target >= self && target < self + sizeof(func);
+		}};
+
+		static_assert(alignof(Function<const void *() const, p2548::inline_alignment<32>, p2548::inline_capacity<32>>) == 32);
+
+		Function<const void *() const, p2548::inline_capacity<32>> f0{functor{}}; //insufficient alignment => heap
+		REQUIRE(!is_inline(f0));
+		REQUIRE(is_aligned(f0()));
+
+		Function<const void *() const, p2548::inline_alignment<32>, p2548::inline_capacity<32>> f1{functor{}};
+		REQUIRE(is_inline(f1));
+		REQUIRE(is_aligned(f1()));
+
+		auto f2{std::move(f1)};
+		REQUIRE(is_inline(f2));
+		REQUIRE(is_aligned(f2()));
+
+		struct alignas(64) big_functor {
+			float lanes[32];
+			auto operator()() const noexcept -> const void * { return this; }
+		};
+		Function<const void *() const> f3{big_functor{}};
+		REQUIRE(reinterpret_cast<std::uintptr_t>(f3()) % 64 == 0);
+	}
+
+
+	template<template<typename...> typename Function>
+	void test_nontype() {
+		Function<int()> f0{p2548::nontype<&func1>};
+		REQUIRE(f0);
+		REQUIRE(f0() == 0);
+
+		Function<int()> f1{p2548::nontype<&non_func::do_>, non_func{1}};
+		REQUIRE(f1() == 1);
+
+		Function<int()> f2{p2548::nontype<&call>, non_func{2}};
+		REQUIRE(f2() == 2);
+
+		auto f3{std::move(f2)};
+		REQUIRE(f3() == 2);
+
+		static_assert(std::is_nothrow_constructible_v<Function<int()>, p2548::nontype_t<&func1>>);
+		static_assert(!std::is_constructible_v<Function<int() const>, p2548::nontype_t<&non_func::do_>, non_func>); //do_ is not const
+		static_assert(!std::is_constructible_v<Function<int(int)>, p2548::nontype_t<&func1>>);
+	}
+
+	template<template<typename...> typename Function>
+	void test_trivially_relocatable() {
+		using function = Function<int(int) const, p2548::trivially_relocatable>;
+		static_assert(std::is_trivially_copyable_v<function>);
+		static_assert(sizeof(function) == sizeof(Function<int(int) const>));
+
+		const auto lambda{[offset = 1](int value) { return value + offset; }};
+		static_assert(std::is_constructible_v<function, decltype(lambda)>);
+		static_assert(std::is_constructible_v<function, int(*)(int)>);
+		static_assert(!std::is_constructible_v<function, std::function<int(int)>>);
+		static_assert(!std::is_constructible_v<function, big_func>);
+
+		std::vector<function> funcs;
+		for(auto i{0}; i < 32; ++i) funcs.emplace_back([i](int value) { return value * i; });
+		for(auto i{0}; i < 32; ++i) REQUIRE(funcs[i](2) == 2 * i);
+
+		function f0{lambda};
+		function f1{std::move(f0)};
+		REQUIRE(f0); //moved-from wrappers retain their target
+		REQUIRE(f1(1) == 2);
+
+		function f2;
+		REQUIRE(!f2);
+		f2 = std::move(f1);
+		REQUIRE(f2(2) == 3);
+		swap(f1, f2);
+		REQUIRE(f1(3) == 4);
+	}
+
+
+	template<typename... Signature>
+	using fat_move_only_function = p2548::move_only_function<Signature..., p2548::inline_dispatch>;
+
+	template<typename... Signature>
+	using fat_copyable_function = p2548::copyable_function<Signature..., p2548::inline_dispatch>;
+
+	static_assert(sizeof(fat_move_only_function<void()>) == 5 * sizeof(void *));
+	static_assert(sizeof(fat_copyable_function<void()>) == 5 * sizeof(void *));
+
+
+	class counting_resource final : public std::pmr::memory_resource {
+		auto do_allocate(std::size_t bytes, std::size_t alignment) -> void * override {
+			++allocations;
+			return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+		}
+
+		void do_deallocate(void * ptr, std::size_t bytes, std::size_t alignment) override {
+			++deallocations;
+			std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+		}
+
+		auto do_is_equal(const std::pmr::memory_resource & other) const noexcept -> bool override { return this == &other; }
+	public:
+		int allocations{0}, deallocations{0};
+	};
+
+
+	template<typename... Signature>
+	using compressed_move_only_function = p2548::move_only_function<Signature..., p2548::compressed_vtable>;
+
+	template<typename... Signature>
+	using compressed_copyable_function = p2548::copyable_function<Signature..., p2548::compressed_vtable>;
+
+	static_assert(sizeof(compressed_move_only_function<void()>) == sizeof(p2548::move_only_function<void()>));
+	static_assert(sizeof(compressed_copyable_function<void()>) == sizeof(p2548::copyable_function<void()>));
+
+	struct packed_func { //captures that only require the alignment of int
+		int vals[sizeof(void *) * 4 / sizeof(int) - 1];
+
+		auto operator()() const -> int { return vals[0]; }
+	};
+
+	template<template<typename...> typename Function>
+	void test_compressed_vtable() {
+		static_assert(!p2548::stores_inline_v<Function<int() const>, packed_func>);
+		static_assert( p2548::stores_inline_v<Function<int() const, p2548::compressed_vtable>, packed_func>);
+		static_assert( p2548::stores_inline_v<Function<int() const, p2548::compressed_vtable, p2548::inline_capacity<sizeof(big_func)>>, big_func>);
+		static_assert( p2548::stores_inline_v<Function<int() const, p2548::inline_capacity<sizeof(big_func)>, p2548::compressed_vtable>, big_func>);
+		static_assert(sizeof(Function<int(), p2548::inline_capacity<64>, p2548::compressed_vtable>) == sizeof(Function<int(), p2548::inline_capacity<64>>)); //the bytes saved are added to any capacity
+		static_assert(sizeof(Function<int(), p2548::compressed_vtable, p2548::inline_capacity<64>>) == sizeof(Function<int(), p2548::inline_capacity<64>>));
+		static_assert(sizeof(Function<int(), p2548::std_function_capacity, p2548::compressed_vtable>) == sizeof(Function<int(), p2548::std_function_capacity>));
+		//fails mutually-exclusive-layouts-assertion: Function<int(), p2548::inline_dispatch, p2548::compressed_vtable>{};
+		static_assert(sizeof(Function<int(), p2548::compressed_vtable, p2548::compressed_vtable>) == sizeof(Function<int(), p2548::compressed_vtable>)); //repeating a layout is not a conflict
+
+		counting_resource resource;
+		const std::pmr::polymorphic_allocator<> alloc{&resource};
+
+		Function<int() const, p2548::compressed_vtable> f0{std::allocator_arg, alloc, packed_func{{1}}};
+		REQUIRE(f0() == 1);
+		Function<int() const, p2548::compressed_vtable> f1{std::allocator_arg, alloc, big_func{2}};
+		REQUIRE(f1() == 2);
+		REQUIRE(resource.allocations == 1);
+
+		f0.swap(f1);
+		REQUIRE(f0() == 2);
+		REQUIRE(f1() == 1);
+		REQUIRE(f1.template target<packed_func>());
+
+		Function<int() const> f2{std::move(f1)}; //different storage => wraps the compressed wrapper
+		REQUIRE(!f1);
+		REQUIRE(f2() == 1);
+	}
+
+	template<template<typename...> typename Function>
+	void test_allocator() {
+		counting_resource resource;
+		const std::pmr::polymorphic_allocator<> alloc{&resource};
+
+		{ //SOO does not allocate
+			Function<int() const> f0{std::allocator_arg, alloc, small_func{1}};
+			REQUIRE(f0() == 1);
+		}
+		REQUIRE(resource.allocations == 0);
+
+		{ //noSOO allocates through the allocator
+			Function<int() const> f1{std::allocator_arg, alloc, std::in_place_type<big_func>, 2};
+			REQUIRE(resource.allocations == 1);
+			REQUIRE(f1() == 2);
+
+			Function<int() const> f2{std::move(f1)};
+			REQUIRE(!f1);
+			REQUIRE(f2() == 2);
+			REQUIRE(resource.allocations == 1);
+			REQUIRE(resource.deallocations == 0);
+		}
+		REQUIRE(resource.deallocations == 1);
+
+		{ //EMPTY
+			Function<int() const> f3{std::allocator_arg, alloc, static_cast<int(*)()>(nullptr)};
+			REQUIRE(!f3);
+		}
+		REQUIRE(resource.allocations == 1);
+	}
+
+	template<template<typename...> typename Function>
+	void test_std_function() {
+		counting_resource resource;
+		const std::pmr::polymorphic_allocator<> alloc{&resource};
+
+		const std::function<int()> empty;
+		REQUIRE(!Function<int()>{empty});
+		REQUIRE(!Function<int()>{std::allocator_arg, alloc, empty});
+		REQUIRE(!Function<int()>{p2548::copyable_function<int(), p2548::inline_dispatch>{}});
+
+		const std::function<int()> func{small_func{3}};
+		{ //does not fit the default inline buffer
+			Function<int()> f0{std::allocator_arg, alloc, func};
+			REQUIRE(f0() == 3);
+			REQUIRE(resource.allocations == 1);
+		}
+		{
+			Function<int(), p2548::std_function_capacity> f1{std::allocator_arg, alloc, func};
+			REQUIRE(f1() == 3);
+			Function<int(), p2548::std_function_capacity> f2{std::allocator_arg, alloc, std::function<int()>{big_func{4}}};
+			REQUIRE(f2() == 4);
+			REQUIRE(resource.allocations == 1);
+		}
+
+		static_assert(sizeof(Function<int(), p2548::std_function_capacity, p2548::inline_capacity<8>>) == 2 * sizeof(void *)); //later policies take precedence
+	}
+
+	template<template<typename...> typename Function>
+	void test_target() {
+		Function<int()> f0;
+		REQUIRE(!f0.template target<small_func>());
+
+		Function<int()> f1{small_func{1}};
+		REQUIRE(f1.template target<small_func>());
+		REQUIRE((*f1.template target<small_func>())() == 1);
+		REQUIRE(!f1.template target<big_func>());
+		*f1.template target<small_func>() = small_func{7};
+		REQUIRE(f1() == 7);
+
+		const Function<int()> f2{big_func{2}};
+		REQUIRE((*f2.template target<big_func>())() == 2);
+
+		const Function<int()> f3{std::allocator_arg, std::pmr::polymorphic_allocator<>{}, std::in_place_type<big_func>, 3};
+		REQUIRE((*f3.template target<big_func>())() == 3);
+
+		const Function<int()> f4{&func2}; //stored as the plain function pointer of the signature
+		REQUIRE(f4.template target<int(*)()>());
+		REQUIRE(*f4.template target<int(*)()>() == static_cast<int(*)()>(&func2));
+		REQUIRE(!f4.template target<int(*)() noexcept>());
+
+		const Function<int()> f5{p2548::nontype<&func1>};
+		REQUIRE(f5.template target<p2548::nontype_t<&func1>>());
+		REQUIRE(!f5.template target<p2548::nontype_t<&func3>>());
+
+		Function<int()> f6{p2548::nontype<&non_func::do_>, non_func{6}};
+		REQUIRE(f6.template target<non_func>()->do_() == 6);
+
+		Function<int() const noexcept> f7{[]() noexcept { return 8; }};
+		const Function<int()> f8{std::move(f7)}; //adopts the target instead of wrapping f7
+		REQUIRE(!f8.template target<Function<int() const noexcept>>());
+
+#if defined(__cpp_rtti) || defined(__GXX_RTTI) || defined(_CPPRTTI)
+		REQUIRE(f0.target_type() == typeid(void));
+		REQUIRE(f1.target_type() == typeid(small_func));
+		REQUIRE(f4.target_type() == typeid(int(*)()));
+		REQUIRE(f6.target_type() == typeid(non_func));
+#endif
+	}
+
+	template<template<typename...> typename Function>
+	void test_inplace_only() {
+		using function = Function<int() const, p2548::inline_capacity<sizeof(void *)>, p2548::inplace_only>;
+		static_assert(std::is_constructible_v<function, small_func>);
+		static_assert(std::is_constructible_v<function, int(*)()>);
+		static_assert(!std::is_constructible_v<function, big_func>);
+		static_assert(!std::is_constructible_v<function, std::in_place_type_t<big_func>, int>);
+		static_assert(!std::is_constructible_v<function, std::allocator_arg_t, std::allocator<int>, big_func>);
+		static_assert(!std::is_constructible_v<function, Function<int() const>>);
+
+		static_assert( p2548::stores_inline_v<Function<int() const>, small_func>);
+		static_assert( p2548::stores_inline_v<Function<int() const>, decltype(func1)>);
+		static_assert(!p2548::stores_inline_v<Function<int() const>, big_func>);
+		static_assert( p2548::stores_inline_v<Function<int() const, p2548::inline_capacity<sizeof(big_func)>>, big_func>);
+		static_assert(!p2548::stores_inline_v<Function<int() const>, non_func>); //not invocable
+
+		//compatible wrappers only holding inline targets are adopted without allocating
+		using relaxed = Function<int(), p2548::inline_capacity<sizeof(void *)>, p2548::inplace_only>;
+		static_assert( p2548::stores_inline_v<relaxed, function>);
+		static_assert(!p2548::stores_inline_v<relaxed, Function<int() const, p2548::inline_capacity<sizeof(void *)>>>); //may hold a heap-allocated target
+		static_assert(!std::is_constructible_v<function, std::in_place_type_t<function>>);
+
+		counting_resource resource;
+		function f0{std::allocator_arg, std::pmr::polymorphic_allocator<>{&resource}, small_func{1}};
+		REQUIRE(f0() == 1);
+		f0.template emplace<small_func>(2);
+		REQUIRE(f0() == 2);
+		f0 = func1;
+		REQUIRE(f0() == 0);
+		relaxed f1{std::move(f0)};
+		REQUIRE(f1() == 0);
+		REQUIRE(resource.allocations == 0);
+	}
+
+	template<template<typename...> typename Function>
+	void test_pinned() {
+		struct throwing_move { //copyable, but its move constructor may throw
+			int val;
+
+			throwing_move(int val) : val{val} {}
+			throwing_move(const throwing_move &) =default;
+			throwing_move(throwing_move && other) noexcept(false) : val{other.val} {}
+
+			auto operator()() const -> int { return val; }
+		};
+
+		using function = Function<int() const, p2548::pinned>;
+		static_assert(!std::is_move_constructible_v<function>);
+		static_assert(!std::is_move_assignable_v<function>);
+		static_assert(!std::is_swappable_v<function>);
+		static_assert(!p2548::stores_inline_v<Function<int() const>, throwing_move>);
+		static_assert( p2548::stores_inline_v<function, throwing_move>);
+
+		counting_resource resource;
+		const std::pmr::polymorphic_allocator<> alloc{&resource};
+
+		function f0{std::allocator_arg, alloc, throwing_move{1}};
+		REQUIRE(f0() == 1);
+		const auto target{reinterpret_cast<const char *>(f0.template target<throwing_move>())};
+		REQUIRE(target >= reinterpret_cast<const char *>(&f0));
+		REQUIRE(target < reinterpret_cast<const char *>(&f0 + 1));
+		f0.template emplace<throwing_move>(2);
+		REQUIRE(f0() == 2);
+		f0 = nullptr;
+		REQUIRE(!f0);
+		f0.template emplace<small_func>(3);
+		REQUIRE(f0() == 3);
+		REQUIRE(resource.allocations == 0);
+	}
+
+	template<template<typename...> typename Function>
+	void test_emplace() {
+		struct big_func2 { //same size as big_func
+			int val;
+			int buffer[10]{};
+
+			auto operator()() const -> int { return -val; }
+		};
+
+		struct throwing {
+			int buffer[16]{};
+
+			throwing() =default;
+			throwing(const throwing &) { throw 0; }
+			auto operator=(const throwing &) -> throwing & =default;
+
+			auto operator()() const -> int { return 0; }
+		};
+
+		Function<int()> f0;
+		f0.template emplace<small_func>(1);
+		REQUIRE(f0() == 1);
+		f0.template emplace<big_func>(2);
+		REQUIRE(f0() == 2);
+		f0.template emplace<big_func>(3); //reuses the heap block
+		REQUIRE(f0() == 3);
+		f0.template emplace<big_func2>(4); //same size class
+		REQUIRE(f0() == -4);
+		f0.template emplace<int(*)()>(&func2);
+		REQUIRE(f0() == 1);
+		REQUIRE(f0.template target<int(*)()>());
+
+		f0.template emplace<big_func>(5);
+		const throwing thrower;
+		REQUIRE_THROWS(f0.template emplace<throwing>(thrower));
+		REQUIRE(!f0);
+
+		f0 = big_func{6};
+		REQUIRE(f0() == 6);
+		REQUIRE_THROWS(f0 = thrower); //strong exception guarantee
+		REQUIRE(f0() == 6);
+		f0 = nullptr;
+		REQUIRE(!f0);
+		f0 = nullptr;
+		REQUIRE(!f0);
+	}
+
+	template<template<typename...> typename Function>
+	void test_cached_invoke() {
+		struct qualified {
+			auto operator()(long value) &       -> long { return value; }
+			auto operator()(long value) const & -> long { return -value; }
+		};
+
+		Function<long(int) const> f0{qualified{}};
+		REQUIRE(p2548::cached_invoke<qualified>(f0, 1) == -1); //invoked with the qualifiers of the signature
+		REQUIRE(p2548::cached_invoke<small_func, qualified>(f0, 2) == -2);
+		REQUIRE(p2548::cached_invoke<small_func>(f0, 3) == -3); //falls back to the dispatch function
+		REQUIRE(p2548::cached_invoke<qualified>(std::as_const(f0), 4) == -4);
+
+		Function<long(int)> f1{qualified{}};
+		REQUIRE(p2548::cached_invoke<qualified>(f1, 5) == 5);
+
+		Function<long(int) const> f5{qualified{}};
+		Function<long(int)> f6{std::move(f5)}; //adopts the target, which is still invoked as const
+		REQUIRE(f6(9) == -9);
+		REQUIRE(p2548::cached_invoke<qualified>(f6, 9) == -9);
+		p2548::call_site_cache<qualified> cache6;
+		REQUIRE(cache6(f6, 9) == -9);
+
+		const Function<int() const> f2{big_func{6}};
+		const Function<int() const> f3{func1};
+		p2548::call_site_cache<small_func, big_func> cache;
+		for(auto i{0}; i < 64; ++i) { //learns big_func, unknown targets do not affect the cache
+			REQUIRE(cache(f2) == 6);
+			REQUIRE(cache(f3) == 0);
+		}
+		REQUIRE(cache(Function<int() const>{small_func{7}}) == 7);
+
+		Function<int() &&> f4{small_func{8}};
+		REQUIRE(p2548::cached_invoke<small_func>(std::move(f4)) == 8);
+	}
 }
 
 TEST_CASE("move_only_function nullptr", "[move_only_function]") { test_nullptr<p2548::move_only_function>(); }
@@ -392,6 +840,79 @@ TEST_CASE("copyable_function moved-from state", "[copyable_function]") { test_mo
 TEST_CASE("move_only_function swapping", "[move_only_function]") { test_swapping<p2548::move_only_function>(); }
 TEST_CASE("copyable_function swapping", "[copyable_function]") { test_swapping<p2548::copyable_function>(); }
 
+TEST_CASE("move_only_function inline capacity", "[move_only_function]") { test_inline_capacity<p2548::move_only_function>(); }
+TEST_CASE("copyable_function inline capacity", "[copyable_function]") { test_inline_capacity<p2548::copyable_function>(); }
+
+TEST_CASE("move_only_function inline alignment", "[move_only_function]") { test_inline_alignment<p2548::move_only_function>(); }
+TEST_CASE("copyable_function inline alignment", "[copyable_function]") { test_inline_alignment<p2548::copyable_function>(); }
+
+TEST_CASE("move_only_function nontype", "[move_only_function]") { test_nontype<p2548::move_only_function>(); }
+TEST_CASE("copyable_function nontype", "[copyable_function]") {
+	test_nontype<p2548::copyable_function>();
+
+	const p2548::copyable_function<int() const> f0{p2548::nontype<&small_func::operator()>, small_func{3}};
+	const auto f1{f0};
+	REQUIRE(f0() == 3);
+	REQUIRE(f1() == 3);
+}
+
+TEST_CASE("move_only_function trivially relocatable", "[move_only_function]") { test_trivially_relocatable<p2548::move_only_function>(); }
+TEST_CASE("copyable_function trivially relocatable", "[copyable_function]") { test_trivially_relocatable<p2548::copyable_function>(); }
+
+TEST_CASE("move_only_function inline dispatch", "[move_only_function]") {
+	test_nullptr<fat_move_only_function>();
+	test_free_function<fat_move_only_function>();
+	test_functor<fat_move_only_function>();
+	test_moved_from_state<fat_move_only_function>();
+	test_swapping<fat_move_only_function>();
+}
+TEST_CASE("copyable_function inline dispatch", "[copyable_function]") {
+	test_nullptr<fat_copyable_function>();
+	test_free_function<fat_copyable_function>();
+	test_functor<fat_copyable_function>();
+	test_moved_from_state<fat_copyable_function>();
+	test_swapping<fat_copyable_function>();
+
+	fat_copyable_function<int() const> f0{std::in_place_type<big_func>, 7};
+	fat_copyable_function<int() const> f1{f0};
+	REQUIRE(f1() == 7);
+
+	p2548::move_only_function<int() const> f2{std::move(f1)};
+	REQUIRE(!f1);
+	REQUIRE(f2() == 7);
+}
+
+TEST_CASE("move_only_function compressed vtable", "[move_only_function]") {
+	test_nullptr<compressed_move_only_function>();
+	test_free_function<compressed_move_only_function>();
+	test_functor<compressed_move_only_function>();
+	test_moved_from_state<compressed_move_only_function>();
+	test_swapping<compressed_move_only_function>();
+	test_compressed_vtable<p2548::move_only_function>();
+}
+TEST_CASE("copyable_function compressed vtable", "[copyable_function]") {
+	test_nullptr<compressed_copyable_function>();
+	test_free_function<compressed_copyable_function>();
+	test_functor<compressed_copyable_function>();
+	test_moved_from_state<compressed_copyable_function>();
+	test_swapping<compressed_copyable_function>();
+	test_compressed_vtable<p2548::copyable_function>();
+
+	compressed_copyable_function<int() const> f0{packed_func{{3}}};
+	compressed_copyable_function<int() const> f1{f0};
+	REQUIRE(f1() == 3);
+	f1 = compressed_copyable_function<int() const>{std::in_place_type<big_func>, 4};
+	f0 = f1;
+	REQUIRE(f0() == 4);
+
+	p2548::copyable_function<int() const, p2548::compressed_vtable, p2548::shared_storage> f2{std::in_place_type<big_func>, 5};
+	auto f3{f2};
+	REQUIRE(f3() == 5);
+}
+
+TEST_CASE("move_only_function allocator", "[move_only_function]") { test_allocator<p2548::move_only_function>(); }
+TEST_CASE("copyable_function allocator", "[copyable_function]") { test_allocator<p2548::copyable_function>(); }
+
 
 TEST_CASE("copyable_function copy ctor", "[copyable_function]") {
 	//EMPTY
@@ -477,6 +998,447 @@ TEST_CASE("copyable_function copy assign", "[copyable_function]") {
 	REQUIRE(mf4);
 }
 
+TEST_CASE("move_only_function from std::function", "[move_only_function]") { test_std_function<p2548::move_only_function>(); }
+TEST_CASE("copyable_function from std::function", "[copyable_function]") { test_std_function<p2548::copyable_function>(); }
+
+TEST_CASE("move_only_function target", "[move_only_function]") { test_target<p2548::move_only_function>(); }
+TEST_CASE("copyable_function target", "[copyable_function]") { test_target<p2548::copyable_function>(); }
+
+TEST_CASE("move_only_function inplace only", "[move_only_function]") {
+	test_inplace_only<p2548::move_only_function>();
+	static_assert(std::is_same_v<p2548::inplace_move_only_function<int(), 16>, p2548::move_only_function<int(), p2548::inline_capacity<16>, p2548::inplace_only>>);
+}
+TEST_CASE("copyable_function inplace only", "[copyable_function]") {
+	test_inplace_only<p2548::copyable_function>();
+	static_assert(std::is_same_v<p2548::inplace_copyable_function<int(), 16>, p2548::copyable_function<int(), p2548::inline_capacity<16>, p2548::inplace_only>>);
+}
+
+TEST_CASE("move_only_function pinned", "[move_only_function]") {
+	test_pinned<p2548::move_only_function>();
+
+	struct immovable {
+		int val;
+
+		immovable(int val) : val{val} {}
+		immovable(const immovable &) =delete;
+
+		auto operator()() const -> int { return val; }
+	};
+
+	counting_resource resource;
+	p2548::move_only_function<int() const, p2548::pinned> f0{std::allocator_arg, std::pmr::polymorphic_allocator<>{&resource}, std::in_place_type<immovable>, 1};
+	REQUIRE(f0() == 1);
+	f0.emplace<immovable>(2);
+	REQUIRE(f0() == 2);
+	REQUIRE(resource.allocations == 0);
+}
+TEST_CASE("copyable_function pinned", "[copyable_function]") {
+	test_pinned<p2548::copyable_function>();
+
+	struct throwing_move {
+		int val;
+
+		throwing_move(int val) : val{val} {}
+		throwing_move(const throwing_move &) =default;
+		throwing_move(throwing_move && other) noexcept(false) : val{other.val} {}
+
+		auto operator()() const -> int { return val; }
+	};
+
+	using function = p2548::copyable_function<int() const, p2548::pinned>;
+	const function f0{std::in_place_type<throwing_move>, 1};
+	function f1{f0};
+	REQUIRE(f1() == 1);
+	function f2{std::in_place_type<big_func>, 2};
+	f2 = f1;
+	REQUIRE(f2() == 1);
+	f1.emplace<throwing_move>(3);
+	f2 = f1;
+	REQUIRE(f2() == 3);
+	REQUIRE(f0() == 1);
+}
+
+TEST_CASE("move_only_function emplace", "[move_only_function]") { test_emplace<p2548::move_only_function>(); }
+TEST_CASE("copyable_function emplace", "[copyable_function]") { test_emplace<p2548::copyable_function>(); }
+
+TEST_CASE("move_only_function cached invoke", "[move_only_function]") { test_cached_invoke<p2548::move_only_function>(); }
+TEST_CASE("copyable_function cached invoke", "[copyable_function]") { test_cached_invoke<p2548::copyable_function>(); }
+
+TEST_CASE("compact_move_only_function", "[compact_move_only_function]") {
+	static_assert(sizeof(p2548::compact_move_only_function<int()>) == sizeof(void *));
+	static_assert(sizeof(p2548::compact_move_only_function<int(), int(int) const>) == sizeof(void *));
+
+	test_nullptr<p2548::compact_move_only_function>();
+	test_inplace<p2548::compact_move_only_function>();
+	test_free_function<p2548::compact_move_only_function>();
+	test_free_function_ptr<p2548::compact_move_only_function>();
+	test_member_function_ptr<p2548::compact_move_only_function>();
+	test_functor<p2548::compact_move_only_function>();
+	test_move_ctor<p2548::compact_move_only_function>();
+	test_move_assign<p2548::compact_move_only_function>();
+	test_moved_from_state<p2548::compact_move_only_function>();
+	test_swapping<p2548::compact_move_only_function>();
+	test_nontype<p2548::compact_move_only_function>();
+
+	const std::function<int()> empty;
+	REQUIRE(!p2548::compact_move_only_function<int()>{empty});
+	REQUIRE(p2548::compact_move_only_function<int()>{std::function<int()>{small_func{3}}}() == 3);
+}
+
+TEST_CASE("compact_move_only_function allocation", "[compact_move_only_function]") {
+	using function = p2548::compact_move_only_function<int() const>;
+	counting_resource resource;
+	const std::pmr::polymorphic_allocator<> alloc{&resource};
+
+	{ //function pointers and stateless functors are encoded in the wrapper
+		function f0{std::allocator_arg, alloc, &func1};
+		REQUIRE(f0() == 0);
+		function f1{std::allocator_arg, alloc, [] { return 1; }};
+		REQUIRE(f1() == 1);
+		function f2{std::allocator_arg, alloc, static_cast<int(*)()>(nullptr)};
+		REQUIRE(!f2);
+		function f3{p2548::nontype<&func3>};
+		REQUIRE(f3() == 2);
+	}
+	REQUIRE(resource.allocations == 0);
+
+	{ //any other functor allocates, including small ones
+		function f4{std::allocator_arg, alloc, small_func{4}};
+		REQUIRE(resource.allocations == 1);
+		REQUIRE(f4() == 4);
+
+		function f5{std::allocator_arg, alloc, std::in_place_type<big_func>, 5};
+		REQUIRE(resource.allocations == 2);
+
+		function f6{std::move(f5)};
+		REQUIRE(!f5);
+		REQUIRE(f6() == 5);
+		f6 = std::move(f4);
+		REQUIRE(f6() == 4);
+		REQUIRE(resource.deallocations == 1);
+	}
+	REQUIRE(resource.deallocations == 2);
+
+	struct observable_empty { //empty, but copying it may have side effects
+		observable_empty() =default;
+		observable_empty(const observable_empty &) noexcept {}
+
+		auto operator()() const -> int { return 7; }
+	};
+	const observable_empty empty;
+	function f7{std::allocator_arg, alloc, empty};
+	REQUIRE(f7() == 7);
+	REQUIRE(resource.allocations == 3);
+
+	struct sum {
+		int value;
+
+		sum(std::initializer_list<int> ilist, int init) noexcept : value{std::accumulate(ilist.begin(), ilist.end(), init)} {}
+
+		auto operator()() const noexcept -> int { return value; }
+	};
+	const function f8{std::allocator_arg, alloc, std::in_place_type<sum>, {1, 2, 3}, 4};
+	REQUIRE(resource.allocations == 4);
+	REQUIRE(f8() == 10);
+}
+
+TEST_CASE("copyable_function allocator copy", "[copyable_function]") {
+	counting_resource resource;
+	const std::pmr::polymorphic_allocator<> alloc{&resource};
+
+	{
+		p2548::copyable_function<int() const> f0{std::allocator_arg, alloc, std::in_place_type<big_func>, 3};
+		p2548::copyable_function<int() const> f1{f0};
+		REQUIRE(resource.allocations == 2);
+		REQUIRE(f0() == 3);
+		REQUIRE(f1() == 3);
+
+		p2548::copyable_function<int() const> f2;
+		f2 = f1;
+		REQUIRE(resource.allocations == 3);
+		REQUIRE(f2() == 3);
+
+		p2548::copyable_function<int() const> f3{std::allocator_arg, alloc, std::in_place_type<big_func>, 4};
+		REQUIRE(resource.allocations == 4);
+		f2 = f3; //same heap-allocated type => reuses the allocation
+		REQUIRE(resource.allocations == 4);
+		REQUIRE(f2() == 4);
+		REQUIRE(f3() == 4);
+	}
+	REQUIRE(resource.deallocations == 4);
+}
+
+TEST_CASE("copyable_function copy assign strong guarantee", "[copyable_function]") {
+	struct throwing {
+		bool * fail;
+		int val;
+		int buffer[10]{};
+
+		throwing(bool * fail, int val) noexcept : fail{fail}, val{val} {}
+		throwing(const throwing & other) : fail{other.fail}, val{other.val} { if(*fail) throw 0; }
+		auto operator=(const throwing & other) -> throwing & {
+			if(*fail) throw 0;
+			val = other.val;
+			return *this;
+		}
+		auto operator=(throwing &&) noexcept -> throwing & =default;
+
+		auto operator()() const -> int { return val; }
+	};
+
+	bool fail{false};
+	p2548::copyable_function<int() const> f0{std::in_place_type<throwing>, &fail, 1};
+	p2548::copyable_function<int() const> f1{std::in_place_type<throwing>, &fail, 2};
+	const auto target{f1.target<throwing>()};
+	f1 = f0;
+	REQUIRE(f1() == 1);
+	REQUIRE(f1.target<throwing>() == target); //assigned in place
+
+	p2548::copyable_function<int() const> f2{std::in_place_type<throwing>, &fail, 3};
+	fail = true;
+	REQUIRE_THROWS(f1 = f2);
+	REQUIRE(f1() == 1);
+	fail = false;
+
+	p2548::copyable_function<int() const> f3{big_func{5}};
+	f3 = f2; //different types => reallocates
+	REQUIRE(f3() == 3);
+}
+
+namespace {
+	struct point {
+		int x, y;
+	};
+}
+
+template<>
+struct p2548::pass_by_value<point> : std::true_type {};
+
+TEST_CASE("argument passing", "[move_only_function] [copyable_function] [function_ref]") {
+	struct message {
+		int * moves;
+		char payload[128]{};
+
+		message(int * moves) noexcept : moves{moves} {}
+		message(const message &) =delete;
+		message(message && other) noexcept : moves{other.moves} { ++*moves; }
+	};
+
+	const auto handler{[](message msg) { return *msg.moves; }};
+
+	int moves{0};
+	p2548::move_only_function<int(message)> f0{handler};
+	REQUIRE(f0(message{&moves}) == 1); //moved once into the target's parameter
+
+	moves = 0;
+	p2548::copyable_function<int(message) const> f1{handler};
+	REQUIRE(f1(message{&moves}) == 1);
+
+	moves = 0;
+	const p2548::function_ref<int(message) const> r0{handler};
+	REQUIRE(r0(message{&moves}) == 1);
+
+	moves = 0;
+	const p2548::function_ref<int(message)> r1{f0}; //bound to the target of f0
+	REQUIRE(r1(message{&moves}) == 1);
+
+	struct node { //incomplete types may be used as parameters
+		p2548::copyable_function<int(node)> callback;
+	};
+	node n{[](node) { return 2; }};
+	REQUIRE(n.callback(node{}) == 2);
+	static_assert(std::is_same_v<p2548::internal_function_ref::param_t<node>, node &&>); //same erased signature whether or not node was complete
+
+	//small trivially copyable types opt into being passed by value
+	static_assert(std::is_same_v<p2548::internal_function_ref::param_t<std::string_view>, std::string_view>);
+	static_assert(std::is_same_v<p2548::internal_function_ref::param_t<const point>, const point>);
+	const p2548::copyable_function<int(point, std::string_view) const> f2{[](point p, std::string_view str) { return p.x + p.y + static_cast<int>(str.size()); }};
+	REQUIRE(f2(point{1, 2}, "abc") == 6);
+	const p2548::function_ref<int(point, std::string_view) const> r2{f2};
+	REQUIRE(r2(point{3, 4}, "") == 7);
+}
+
+TEST_CASE("multiple signatures", "[move_only_function] [copyable_function]") {
+	struct visitor {
+		int * copies;
+		int calls{0};
+
+		visitor(int * copies) noexcept : copies{copies} {}
+		visitor(const visitor & other) noexcept : copies{other.copies}, calls{other.calls} { ++*copies; }
+		visitor(visitor &&) noexcept =default;
+
+		auto operator()(int value) -> int { ++calls; return value * 2; }
+		auto operator()(std::string_view str) const -> int { return static_cast<int>(str.size()); }
+		auto operator()() const noexcept -> int { return calls; }
+	};
+
+	using function = p2548::copyable_function<int(int), int(std::string_view) const, int() const noexcept>;
+	static_assert(sizeof(function) == sizeof(p2548::copyable_function<int(int)>));
+	static_assert(std::is_constructible_v<function, visitor>);
+	static_assert(!std::is_constructible_v<function, small_func>);
+	static_assert(noexcept(std::declval<const function &>()()));
+
+	int copies{0};
+	function f0{visitor{&copies}};
+	REQUIRE(f0);
+	REQUIRE(f0(21) == 42);
+	REQUIRE(f0("abc") == 3);
+	REQUIRE(std::as_const(f0)() == 1);
+
+	auto f1{f0};
+	REQUIRE(copies == 1);
+	REQUIRE(f1() == 1);
+
+	function f2;
+	REQUIRE(!f2);
+	f2 = std::move(f1);
+	REQUIRE(!f1);
+	REQUIRE(f2("hello") == 5);
+
+	p2548::move_only_function<int(int), int(std::string_view) const, p2548::inline_capacity<sizeof(void *)>, p2548::inline_dispatch> f3{visitor{&copies}};
+	REQUIRE(f3(1) == 2);
+	REQUIRE(f3("") == 0);
+	p2548::move_only_function<int(int), int(std::string_view) const, p2548::inline_capacity<sizeof(void *)>, p2548::inline_dispatch> f4{std::move(f3)};
+	REQUIRE(!f3);
+	REQUIRE(f4(2) == 4);
+}
+
+TEST_CASE("copyable_function relocation", "[copyable_function]") {
+	struct functor {
+		functor * self{this};
+		int value;
+
+		functor(int value) noexcept : value{value} {}
+		functor(const functor & other) : value{other.value} {} //may throw => copy assignment goes through a temporary
+		functor(functor && other) noexcept : value{other.value} {}
+
+		auto operator()() const noexcept -> int { return self == this ? value : -1; }
+	};
+
+	const p2548::copyable_function<int() const> f0{functor{7}};
+	p2548::copyable_function<int() const> f1{small_func{1}};
+	f1 = f0;
+	REQUIRE(f1() == 7);
+
+	auto f2{std::move(f1)};
+	REQUIRE(f2() == 7);
+	f1 = std::move(f2);
+	REQUIRE(f1() == 7);
+	swap(f1, f2);
+	REQUIRE(f2() == 7);
+}
+
+TEST_CASE("pool_allocator", "[move_only_function] [copyable_function]") {
+	p2548::pool_allocator<big_func> alloc;
+	const auto ptr0{alloc.allocate(1)};
+	alloc.deallocate(ptr0, 1);
+	const auto ptr1{alloc.allocate(1)};
+	REQUIRE(ptr0 == ptr1); //served from the thread-local free list
+	alloc.deallocate(ptr1, 1);
+
+	p2548::copyable_function<int() const> f0{std::allocator_arg, alloc, std::in_place_type<big_func>, 4};
+	p2548::copyable_function<int() const> f1{f0};
+	REQUIRE(f0() == 4);
+	REQUIRE(f1() == 4);
+
+	p2548::move_only_function<int() const> f2{std::allocator_arg, alloc, big_func{5}};
+	REQUIRE(f2() == 5);
+}
+
+TEST_CASE("copyable_function shared storage", "[copyable_function]") {
+	struct functor {
+		int * copies;
+		void * buffer[4]{};
+
+		functor(int * copies) noexcept : copies{copies} {}
+		functor(const functor & other) noexcept : copies{other.copies} { ++*copies; }
+
+		auto operator()() const noexcept -> const void * { return this; }
+	};
+
+	int copies{0};
+	p2548::copyable_function<const void *() const, p2548::shared_storage> f0{std::in_place_type<functor>, &copies};
+	p2548::copyable_function<const void *() const, p2548::shared_storage> f1{f0};
+	p2548::copyable_function<const void *() const, p2548::shared_storage> f2;
+	f2 = f1;
+	REQUIRE(copies == 0);
+	REQUIRE(f0() == f1());
+	REQUIRE(f0() == f2());
+
+	//non-const signature clones on invocation while shared
+	p2548::copyable_function<const void *(), p2548::shared_storage> f3{std::in_place_type<functor>, &copies};
+	p2548::copyable_function<const void *(), p2548::shared_storage> f4{f3};
+	REQUIRE(copies == 0);
+	const auto target3{f3()};
+	REQUIRE(copies == 1);
+	REQUIRE(f4() != target3);
+	REQUIRE(copies == 1);
+	REQUIRE(f3() == target3);
+	REQUIRE(copies == 1);
+
+	//inline functors are still copied
+	p2548::copyable_function<int() const, p2548::shared_storage> f5{small_func{6}};
+	p2548::copyable_function<int() const, p2548::shared_storage> f6{f5};
+	REQUIRE(f5() == 6);
+	REQUIRE(f6() == 6);
+
+	//mutable access to a shared target clones it
+	REQUIRE(std::as_const(f0).target<functor>() == f1());
+	REQUIRE(copies == 1);
+	REQUIRE(f0.target<functor>() != f1());
+	REQUIRE(copies == 2);
+	REQUIRE(f0.target<functor>() == f0());
+	REQUIRE(copies == 2);
+	const auto target9{f3()};
+	REQUIRE(copies == 2);
+	REQUIRE(p2548::cached_invoke<functor>(f3) == target9);
+	p2548::copyable_function<const void *(), p2548::shared_storage> f9{f3};
+	REQUIRE(p2548::cached_invoke<functor>(f9) != target9); //unshares like the non-const call operator
+	REQUIRE(copies == 3);
+
+	//allocated
+	counting_resource resource;
+	{
+		p2548::copyable_function<const void *(), p2548::shared_storage> f7{std::allocator_arg, std::pmr::polymorphic_allocator<>{&resource}, std::in_place_type<functor>, &copies};
+		p2548::copyable_function<const void *(), p2548::shared_storage> f8{f7};
+		REQUIRE(resource.allocations == 1);
+		f8();
+		REQUIRE(resource.allocations == 2);
+	}
+	REQUIRE(resource.deallocations == 2);
+
+	//cloning within noexcept non-const signatures requires functors that are nothrow copy constructible
+	struct throwing_copy {
+		int * copies;
+		void * buffer[4]{};
+
+		throwing_copy(int * copies) noexcept : copies{copies} {}
+		throwing_copy(const throwing_copy & other) : copies{other.copies} { ++*copies; }
+
+		auto operator()() const noexcept -> const void * { return this; }
+	};
+	static_assert(std::is_constructible_v<p2548::copyable_function<const void *() const noexcept, p2548::shared_storage>, throwing_copy>);
+	static_assert(std::is_constructible_v<p2548::copyable_function<const void *(), p2548::shared_storage>, throwing_copy>);
+	static_assert(!std::is_constructible_v<p2548::copyable_function<const void *() noexcept, p2548::shared_storage>, throwing_copy>);
+	static_assert(std::is_constructible_v<p2548::copyable_function<const void *() noexcept, p2548::shared_storage>, std::in_place_type_t<functor>, int *>);
+
+	//conversions only adopt shared targets that can be cloned without throwing, others are wrapped and never cloned
+	copies = 0;
+	const p2548::copyable_function<const void *() const noexcept, p2548::shared_storage> f10{std::in_place_type<functor>, &copies};
+	p2548::copyable_function<const void *() noexcept, p2548::shared_storage> f11{f10};
+	REQUIRE(f11.target<functor>() != nullptr); //adopted
+	REQUIRE(copies == 1); //mutable access unshared it
+	const p2548::copyable_function<const void *() const noexcept, p2548::shared_storage> f12{std::in_place_type<throwing_copy>, &copies};
+	p2548::copyable_function<const void *() noexcept, p2548::shared_storage> f13{f12};
+	auto f14{f13};
+	REQUIRE(f13.target<throwing_copy>() == nullptr); //wrapped
+	REQUIRE(f13() == f12());
+	REQUIRE(f14() == f12());
+	p2548::move_only_function<const void *() noexcept> f15{f12};
+	REQUIRE(f15() == f12());
+	REQUIRE(copies == 1);
+}
+
 TEST_CASE("copyable_function conversion", "[move_only_function] [copyable_function]") {
 	//EMPTY
 	p2548::copyable_function<int() const> cf0;
@@ -36,6 +36,10 @@ static_assert(std::is_same_v<decltype(p2548::function_ref{func1}), free_throwing
 static_assert(std::is_same_v<decltype(p2548::function_ref{&func1}), free_throwing>);
 static_assert(std::is_same_v<decltype(p2548::function_ref{func2}), free_noexcept>);
 static_assert(std::is_same_v<decltype(p2548::function_ref{&func2}), free_noexcept>);
+static_assert(std::is_same_v<decltype(p2548::function_ref{p2548::nontype<func1>}), free_throwing>);
+static_assert(std::is_same_v<decltype(p2548::function_ref{p2548::nontype<&func2>}), free_noexcept>);
+static_assert(std::is_same_v<decltype(p2548::function_ref{p2548::nontype<&non_func::do_>, nf}), free_throwing>);
+static_assert(std::is_same_v<decltype(p2548::function_ref{p2548::nontype<&foo>, &nf}), free_throwing>);
 
 TEST_CASE("function_ref function", "[function_ref]") {
 	free_throwing ref1{func1};
@@ -81,3 +85,28 @@ TEST_CASE("function_ref functor", "[function_ref]") {
 	REQUIRE(ref4() == 3);
 	static_assert(!std::is_constructible_v<const_free_noexcept, decltype(func4)>);
 }
+
+TEST_CASE("function_ref nontype", "[function_ref]") {
+	free_throwing ref1{p2548::nontype<func1>};
+	REQUIRE(ref1() == 0);
+	const_free_noexcept cref2{p2548::nontype<&func2>};
+	REQUIRE(cref2() == 1);
+
+	non_func obj{4};
+	const_free_throwing ref3{p2548::nontype<&non_func::do_>, obj};
+	REQUIRE(ref3() == 4);
+	free_throwing ref4{p2548::nontype<&non_func::do_>, &obj};
+	REQUIRE(ref4() == 4);
+	free_throwing ref5{p2548::nontype<&foo>, &obj};
+	REQUIRE(ref5() == 4);
+	const_free_throwing ref6{p2548::nontype<&bar>, &std::as_const(obj)};
+	REQUIRE(ref6() == 4);
+
+	obj = non_func{5}; //binds the object, not a copy
+	REQUIRE(ref3() == 5);
+	REQUIRE(ref4() == 5);
+
+	static_assert(!std::is_constructible_v<free_throwing, p2548::nontype_t<&non_func::do_>, non_func>); //rvalues would dangle
+	static_assert(!std::is_constructible_v<const_free_throwing, p2548::nontype_t<&foo>, non_func *>); //foo requires a mutable object
+	static_assert(!std::is_constructible_v<free_noexcept, p2548::nontype_t<&func1>>);
+}
@@ -0,0 +1,73 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+//built as a separate executable with P2548_POOLED_ALLOCATION defined, as the setting must be consistent across all translation units
+#if !defined(P2548_POOLED_ALLOCATION)
+	#error "pooled_allocation.cpp requires P2548_POOLED_ALLOCATION"
+#endif
+
+#include <catch.hpp>
+#include <thread>
+#include <copyable_function.hpp>
+
+
+namespace {
+	template<std::size_t Size>
+	struct functor {
+		void * buffer[Size / sizeof(void *)]{};
+
+		auto operator()() const noexcept -> const void * { return this; }
+	};
+}
+
+
+TEST_CASE("pooled allocation", "[move_only_function] [copyable_function]") {
+	using f64 = functor<64>;
+	using f48 = functor<48>;
+	static_assert(!p2548::stores_inline_v<p2548::move_only_function<const void *() const>, f64>);
+	static_assert(!p2548::stores_inline_v<p2548::move_only_function<const void *() const>, f48>);
+
+	//blocks are reused by targets of the same size class
+	p2548::move_only_function<const void *() const> f0{f64{}};
+	const auto block0{f0()};
+	f0 = nullptr;
+	p2548::move_only_function<const void *() const> f1{f48{}};
+	REQUIRE(f1() == block0);
+
+	//copies draw from and return to the same (last in, first out) free list
+	p2548::copyable_function<const void *() const> f2{f64{}};
+	const auto block2{f2()};
+	const void * block3;
+	{
+		const p2548::copyable_function<const void *() const> f3{f2};
+		block3 = f3();
+		REQUIRE(block3 != block2);
+	}
+	f2 = nullptr;
+	const p2548::copyable_function<const void *() const> f4{f64{}};
+	const p2548::copyable_function<const void *() const> f5{f4};
+	REQUIRE(f4() == block2);
+	REQUIRE(f5() == block3);
+}
+
+TEST_CASE("pooled allocation across threads", "[move_only_function]") {
+	using f64 = functor<64>;
+
+	//blocks are cached by the thread destroying the target, not returned to the thread that created it
+	p2548::move_only_function<const void *() const> f0{f64{}};
+	const auto block0{f0()};
+	const void * block1{nullptr};
+	const void * block2{nullptr};
+	std::thread{[&] {
+		auto f1{std::move(f0)};
+		block1 = f1();
+		f1 = nullptr;
+		const p2548::move_only_function<const void *() const> f2{f64{}};
+		block2 = f2();
+	}}.join();
+	REQUIRE(block1 == block0);
+	REQUIRE(block2 == block0); //reused by the worker, its cache is released when it exits
+}